@@ -100,7 +100,14 @@ class ASTSimpleOptionalToBox final : public ASTToBox {
 class ASTSimpleToBox final : public ASTToBox {
     using ASTToBox::ASTToBox;
     Value* generate(FunctionCodeGenerator *fg) const override;
+    /// Boxes constants that are stored in the box directly, i.e. values that are not remote, unless boxed for a
+    /// protocol.
+    llvm::Constant* generateConstant(FunctionCodeGenerator *fg) const override;
     void toCode(PrettyStream &pretty) const override {}
+
+public:
+    /// @returns True if a constant value of the contained type can be boxed by generateConstant().
+    bool canBoxConstant(FunctionCodeGenerator *fg) const;
 };
 
 class ASTBoxToSimple final : public ASTBoxing {
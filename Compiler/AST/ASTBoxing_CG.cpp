@@ -111,6 +111,39 @@ Value* ASTSimpleToBox::generate(FunctionCodeGenerator *fg) const {
     return fg->builder().CreateLoad(box);
 }
 
+bool ASTSimpleToBox::canBoxConstant(FunctionCodeGenerator *fg) const {
+    auto boxedFor = expressionType().boxedFor();
+    auto containedType = expr_->expressionType().unboxed().unoptionalized();
+    return !isValueTypeInit() && boxedFor.type() != TypeType::Protocol && boxedFor.type() != TypeType::MultiProtocol &&
+        !fg->typeHelper().isRemote(containedType);
+}
+
+llvm::Constant* ASTSimpleToBox::generateConstant(FunctionCodeGenerator *fg) const {
+    if (!canBoxConstant(fg)) {
+        return nullptr;
+    }
+    auto value = expr_->generateConstant(fg);
+    if (value == nullptr) {
+        return nullptr;
+    }
+    if (value->getType()->isIntegerTy(1)) {
+        value = llvm::ConstantExpr::getZExt(value, llvm::Type::getInt8Ty(fg->ctx()));
+    }
+
+    // The box type cannot be used as the value does not have the type of the value area, hence a packed struct of
+    // the same size is created.
+    auto boxType = llvm::cast<llvm::StructType>(fg->typeHelper().box());
+    auto valueAreaSize = llvm::cast<llvm::ArrayType>(boxType->getElementType(1))->getNumElements();
+    auto padding = llvm::ArrayType::get(llvm::Type::getInt8Ty(fg->ctx()),
+                                        valueAreaSize - fg->generator()->querySize(value->getType()));
+    return llvm::ConstantStruct::getAnon({
+        llvm::ConstantExpr::getBitCast(fg->boxInfoFor(expr_->expressionType().unoptionalized()),
+                                       boxType->getElementType(0)),
+        value,
+        llvm::Constant::getNullValue(padding)
+    }, true);
+}
+
 Value* ASTSimpleOptionalToBox::generate(FunctionCodeGenerator *fg) const {
     auto value = expr_->generate(fg);
 
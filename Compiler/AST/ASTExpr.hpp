@@ -17,6 +17,7 @@
 #include <memory>
 
 namespace llvm {
+class Constant;
 class Value;
 }  // namespace llvm
 
@@ -52,6 +53,11 @@ public:
     /// Subclasses must override this method to generate IR.
     /// If the expression potentially evaluates to an managed value, handleResult() must be called.
     virtual Value* generate(FunctionCodeGenerator *fg) const = 0;
+    /// Evaluates the expression at compile time if possible, without generating any instructions. The constant can
+    /// be used to initialize globals but, like a box, does not necessarily have the type generate() returns.
+    /// Managed values in a constant are immortal and therefore need not be released.
+    /// @returns The value of the expression or `nullptr` if it cannot be evaluated at compile time.
+    virtual llvm::Constant* generateConstant(FunctionCodeGenerator *fg) const { return nullptr; }
     virtual void analyseMemoryFlow(MFFunctionAnalyser *analyser, MFFlowCategory type) = 0;
 
     /// Informs this expression that if it creates a temporary object the object must not be released after the
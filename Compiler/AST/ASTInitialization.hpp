@@ -45,9 +45,11 @@ public:
 
     void allocateOnStack() override;
 
+    /// Allocates an object of `type` and initializes it with `function`.
+    /// @param argumentValues Already generated arguments, which are passed after the arguments in `args`.
     static Value *initObject(FunctionCodeGenerator *fg, const ASTArguments &args, Function *function,
                              const Type &type, llvm::Value *errorPointer, bool stackInit,
-                             llvm::Value *gArgsDescs);
+                             llvm::Value *gArgsDescs, const std::vector<llvm::Value *> &argumentValues = {});
 
     bool isErrorProne() const override;
     const Type& errorType() const override;
@@ -77,11 +77,14 @@ Value* ASTInitialization::generateInitValueType(FunctionCodeGenerator *fg) const
 
 Value* ASTInitialization::initObject(FunctionCodeGenerator *fg, const ASTArguments &args, Function *function,
                                      const Type &type, llvm::Value *errorPointer, bool stackInit,
-                                     llvm::Value *gArgsDescs) {
+                                     llvm::Value *gArgsDescs, const std::vector<llvm::Value *> &argumentValues) {
     auto llvmType = llvm::dyn_cast<llvm::PointerType>(fg->typeHelper().llvmTypeFor(type));
     auto obj = stackInit ? fg->stackAlloc(llvmType) : fg->alloc(llvmType);
     fg->builder().CreateStore(type.klass()->classInfo(), fg->buildGetClassInfoPtrFromObject(obj));
-    auto suppl = gArgsDescs != nullptr ? std::vector<llvm::Value*> { gArgsDescs } : std::vector<llvm::Value*>();
+    auto suppl = argumentValues;
+    if (gArgsDescs != nullptr) {
+        suppl.emplace_back(gArgsDescs);
+    }
     return CallCodeGenerator(fg, CallType::StaticDispatch).generate(obj, type, args, function, errorPointer, suppl);
 }
 
@@ -181,17 +181,34 @@ Type ASTInterpolationLiteral::analyse(ExpressionAnalyser *analyser) {
                                                     {Type(analyser->compiler()->sString)}, Type(sb),
                                                     analyser->typeContext(), analyser->semanticAnalyser());
 
-    get_ = sb.typeDefinition()->methods().lookup(U"🔡", Mood::Imperative, {}, Type(sb),
+    get_ = sb.typeDefinition()->methods().lookup(U"📤", Mood::Imperative, {}, Type(sb),
                                                  analyser->typeContext(), analyser->semanticAnalyser());
 
+    auto string = analyser->compiler()->sString->type();
+    size_ = string.typeDefinition()->methods().lookup(U"📐", Mood::Imperative, {}, string,
+                                                      analyser->typeContext(), analyser->semanticAnalyser());
+
     auto magnet = Type(analyser->compiler()->sInterpolateable).applyMinimalBoxing().referenced();
     toString_ = magnet.typeDefinition()->methods().lookup(U"🔡", Mood::Imperative, {}, magnet,
                                                           analyser->typeContext(), analyser->semanticAnalyser());
 
     for (auto &value : values_) {
-        analyser->expectType(magnet, &value);
+        // Strings are appended directly instead of being boxed and converted with 🔡.
+        if (isString(analyser->analyse(value), analyser->compiler())) {
+            analyser->comply(TypeExpectation(string), &value);
+            continue;
+        }
+        auto type = analyser->comply(TypeExpectation(magnet), &value);
+        if (!type.compatibleTo(magnet, analyser->typeContext())) {
+            throw CompilerError(value->position(), type.toString(analyser->typeContext()), " is not compatible to ",
+                                magnet.toString(analyser->typeContext()), ".");
+        }
     }
-    return analyser->compiler()->sString->type();
+    return string;
+}
+
+bool ASTInterpolationLiteral::isString(const Type &type, Compiler *compiler) {
+    return type.type() == TypeType::Class && type.klass() == compiler->sString;
 }
 
 void ASTInterpolationLiteral::analyseMemoryFlow(MFFunctionAnalyser *analyser, MFFlowCategory type) {
@@ -15,6 +15,7 @@
 
 namespace EmojicodeCompiler {
 
+class Compiler;
 class FunctionAnalyser;
 class CommonTypeFinder;
 
@@ -23,6 +24,9 @@ public:
     ASTStringLiteral(std::u32string value, const SourcePosition &p) : ASTExpr(p), value_(std::move(value)) {}
     Type analyse(ExpressionAnalyser *analyser) override;
     Value* generate(FunctionCodeGenerator *fg) const override;
+    llvm::Constant* generateConstant(FunctionCodeGenerator *fg) const override;
+
+    const std::u32string& value() const { return value_; }
 
     void toCode(PrettyStream &pretty) const override;
     void analyseMemoryFlow(MFFunctionAnalyser *analyser, MFFlowCategory type) override {}
@@ -49,6 +53,7 @@ public:
     Type analyse(ExpressionAnalyser *analyser) override;
     explicit ASTBooleanFalse(const SourcePosition &p) : ASTExpr(p) {}
     Value* generate(FunctionCodeGenerator *fg) const override;
+    llvm::Constant* generateConstant(FunctionCodeGenerator *fg) const override;
 
     void toCode(PrettyStream &pretty) const override;
     void analyseMemoryFlow(MFFunctionAnalyser *, MFFlowCategory) override {}
@@ -59,6 +64,7 @@ public:
     Type analyse(ExpressionAnalyser *analyser) override;
     explicit ASTBooleanTrue(const SourcePosition &p) : ASTExpr(p) {}
     Value* generate(FunctionCodeGenerator *fg) const override;
+    llvm::Constant* generateConstant(FunctionCodeGenerator *fg) const override;
 
     void toCode(PrettyStream &pretty) const override;
     void analyseMemoryFlow(MFFunctionAnalyser *, MFFlowCategory) override {}
@@ -73,11 +79,16 @@ public:
 
     Type analyse(ExpressionAnalyser *analyser) override;
     Value* generate(FunctionCodeGenerator *fg) const override;
+    llvm::Constant* generateConstant(FunctionCodeGenerator *fg) const override;
     Type comply(ExpressionAnalyser *analyser, const TypeExpectation &expectation) override;
 
     void toCode(PrettyStream &pretty) const override;
     void analyseMemoryFlow(MFFunctionAnalyser *, MFFlowCategory) override {}
 
+    /// Whether the literal is of type 🔢, in which case integerValue() returns its value.
+    bool isInteger() const { return type_ == NumberType::Integer; }
+    int64_t integerValue() const { return integerValue_; }
+
 private:
     enum class NumberType {
         Double, Integer, Byte
@@ -97,6 +108,10 @@ public:
     Type comply(ExpressionAnalyser *analyser, const TypeExpectation &expectation) override;
 
     Value* generate(FunctionCodeGenerator *fg) const override;
+    /// Non-empty 🍨 literals whose elements are all constants are evaluated to a 🍨 whose storage is an immortal
+    /// global. 🍨 copies its storage before mutating it if it is not the only reference to it, which is never the
+    /// case for an immortal object, so the global is never modified.
+    llvm::Constant* generateConstant(FunctionCodeGenerator *fg) const override;
     void toCode(PrettyStream &pretty) const override;
     void analyseMemoryFlow(MFFunctionAnalyser *, MFFlowCategory) override;
 
@@ -115,6 +130,8 @@ protected:
     bool pairs_ = false;
     std::unique_ptr<CommonTypeFinder> finder_;
     Value* generatePairs(FunctionCodeGenerator *fg) const;
+    /// @returns True if generateConstant() succeeds. Nested literals are checked without creating their globals.
+    bool isConstant(FunctionCodeGenerator *fg) const;
     Type complyPairs(ExpressionAnalyser *analyser, const TypeExpectation &expectation);
 };
 
@@ -125,6 +142,8 @@ public:
     void addLiteral(const std::u32string &literal) { literals_.emplace_back(literal); }
     void addValue(const std::shared_ptr<ASTExpr> &value) { values_.emplace_back(value); }
     Value* generate(FunctionCodeGenerator *fg) const override;
+    /// Interpolations of only string and integer literals are evaluated to a pooled string.
+    llvm::Constant* generateConstant(FunctionCodeGenerator *fg) const override;
 
     void toCode(PrettyStream &pretty) const override;
     void analyseMemoryFlow(MFFunctionAnalyser *, MFFlowCategory) override;
@@ -136,6 +155,10 @@ private:
     Function *append_ = nullptr;
     Function *get_ = nullptr;
     Function *toString_ = nullptr;
+    /// 📐 of 🔡, which is used to determine the capacity of the builder before appending the strings.
+    Function *size_ = nullptr;
+    /// @returns True if a value of this type is a 🔡 that is appended without conversion.
+    static bool isString(const Type &type, Compiler *compiler);
     void append(FunctionCodeGenerator *fg, llvm::Value *value, llvm::Value *builder) const;
     void append(FunctionCodeGenerator *fg, const std::u32string &literal, llvm::Value *builder) const;
 };
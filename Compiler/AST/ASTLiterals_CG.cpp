@@ -6,7 +6,9 @@
 //  Copyright © 2017 Theo Weidmann. All rights reserved.
 //
 
+#include <algorithm>
 #include <utility>
+#include "ASTBoxing.hpp"
 #include "ASTInitialization.hpp"
 #include "ASTLiterals.hpp"
 #include "Generation/TypeDescriptionGenerator.hpp"
@@ -16,10 +18,16 @@
 #include "Generation/FunctionCodeGenerator.hpp"
 #include "Generation/StringPool.hpp"
 #include "Types/Class.hpp"
+#include "Types/ValueType.hpp"
+#include "Utils/StringUtils.hpp"
 
 namespace EmojicodeCompiler {
 
 Value* ASTStringLiteral::generate(FunctionCodeGenerator *fg) const {
+    return generateConstant(fg);
+}
+
+llvm::Constant* ASTStringLiteral::generateConstant(FunctionCodeGenerator *fg) const {
     return fg->generator()->stringPool().pool(value_);
 }
 
@@ -28,14 +36,26 @@ Value* ASTCGUTF8Literal::generate(FunctionCodeGenerator *fg) const {
 }
 
 Value* ASTBooleanTrue::generate(FunctionCodeGenerator *fg) const {
+    return generateConstant(fg);
+}
+
+llvm::Constant* ASTBooleanTrue::generateConstant(FunctionCodeGenerator *fg) const {
     return llvm::ConstantInt::getTrue(fg->ctx());
 }
 
 Value* ASTBooleanFalse::generate(FunctionCodeGenerator *fg) const {
+    return generateConstant(fg);
+}
+
+llvm::Constant* ASTBooleanFalse::generateConstant(FunctionCodeGenerator *fg) const {
     return llvm::ConstantInt::getFalse(fg->ctx());
 }
 
 Value* ASTNumberLiteral::generate(FunctionCodeGenerator *fg) const {
+    return generateConstant(fg);
+}
+
+llvm::Constant* ASTNumberLiteral::generateConstant(FunctionCodeGenerator *fg) const {
     switch (type_) {
         case NumberType::Byte:
             return fg->int8(integerValue_);
@@ -85,8 +105,81 @@ std::pair<llvm::Value *, llvm::Value *> EmojicodeCompiler::ASTCollectionLiteral:
 }
 
 
+/// @returns True if a type description of `type` must be assembled at run time.
+static bool hasGenericVariables(const Type &type) {
+    auto notype = type.unoptionalized().unboxed();
+    if (notype.type() == TypeType::GenericVariable || notype.type() == TypeType::LocalGenericVariable) {
+        return true;
+    }
+    return notype.canHaveGenericArguments() &&
+        std::any_of(notype.genericArguments().begin(), notype.genericArguments().end(), hasGenericVariables);
+}
+
+bool ASTCollectionLiteral::isConstant(FunctionCodeGenerator *fg) const {
+    if (pairs_ || values_.empty() || type_.typeDefinition() != fg->compiler()->sList ||
+        std::any_of(type_.genericArguments().begin(), type_.genericArguments().end(), hasGenericVariables)) {
+        return false;
+    }
+    return std::all_of(values_.begin(), values_.end(), [fg](const std::shared_ptr<ASTExpr> &value) {
+        auto box = std::dynamic_pointer_cast<ASTSimpleToBox>(value);
+        auto literal = box != nullptr ? std::dynamic_pointer_cast<ASTCollectionLiteral>(box->expr()) : nullptr;
+        if (literal == nullptr) {
+            // Other constants create no globals apart from pooled strings, which are reused when folding.
+            return value->generateConstant(fg) != nullptr;
+        }
+        return box->canBoxConstant(fg) && literal->isConstant(fg);
+    });
+}
+
+llvm::Constant* ASTCollectionLiteral::generateConstant(FunctionCodeGenerator *fg) const {
+    // All elements are checked before any global is created, as a nested literal's globals would otherwise remain
+    // unused if a later element cannot be folded.
+    if (!isConstant(fg)) {
+        return nullptr;
+    }
+    std::vector<llvm::Constant *> elements;
+    for (auto &value : values_) {
+        elements.emplace_back(value->generateConstant(fg));
+    }
+
+    auto list = fg->compiler()->sList;
+
+    auto memory = llvm::ConstantStruct::getAnon({
+        fg->generator()->runTime().ignoreBlockPtr(),
+        llvm::ConstantStruct::getAnon(elements, true)
+    });
+    auto memoryVar = new llvm::GlobalVariable(*fg->generator()->module(), memory->getType(), true,
+                                              llvm::GlobalValue::LinkageTypes::PrivateLinkage, memory, "items");
+
+    auto listLlvm = llvm::cast<llvm::StructType>(fg->typeHelper().llvmTypeFor(type_));
+    auto storagePtrType = listLlvm->getElementType(listLlvm->getNumElements() - 1);
+    auto storageLlvm = llvm::cast<llvm::StructType>(storagePtrType->getPointerElementType());
+    auto storageClass = list->instanceVariables().back().type->type().klass();
+    auto count = fg->int64(values_.size());
+    auto storage = llvm::ConstantStruct::get(storageLlvm, {
+        fg->generator()->runTime().ignoreBlockPtr(),
+        storageClass->classInfo(),
+        llvm::ConstantExpr::getBitCast(memoryVar, storageLlvm->getElementType(2)),
+        count,
+        count
+    });
+    auto storageVar = new llvm::GlobalVariable(*fg->generator()->module(), storageLlvm, true,
+                                               llvm::GlobalValue::LinkageTypes::PrivateLinkage, storage, "list");
+
+    std::vector<llvm::Constant *> fields;
+    if (list->storesGenericArgs()) {
+        auto td = TypeDescriptionGenerator(fg, TypeDescriptionUser::ValueTypeOrValue).generate(type_.genericArguments());
+        fields.emplace_back(llvm::cast<llvm::Constant>(td));
+    }
+    fields.emplace_back(storageVar);
+    return llvm::ConstantStruct::get(listLlvm, fields);
+}
+
 Value* ASTCollectionLiteral::generate(FunctionCodeGenerator *fg) const {
     if (pairs_) return generatePairs(fg);
+    if (auto constant = generateConstant(fg)) {
+        return constant;
+    }
     llvm::Value *current, *structure;
     std::tie(current, structure) = prepareValueArray(fg, fg->typeHelper().box(), values_.size(), "items");
     for (auto &value : values_) {
@@ -114,25 +207,72 @@ Value *ASTCollectionLiteral::generatePairs(FunctionCodeGenerator *fg) const {
 }
 
 
+llvm::Constant* ASTInterpolationLiteral::generateConstant(FunctionCodeGenerator *fg) const {
+    auto literalsIt = literals_.begin();
+    std::u32string string = *literalsIt++;
+    for (auto &value : values_) {
+        if (auto literal = std::dynamic_pointer_cast<ASTStringLiteral>(value)) {
+            string.append(literal->value());
+        }
+        else if (auto box = std::dynamic_pointer_cast<ASTSimpleToBox>(value)) {
+            // 🔢’s 🔡 formats in base 10 just like std::to_string().
+            auto number = std::dynamic_pointer_cast<ASTNumberLiteral>(box->expr());
+            if (number == nullptr || !number->isInteger()) {
+                return nullptr;
+            }
+            auto digits = std::to_string(number->integerValue());
+            string.append(digits.begin(), digits.end());
+        }
+        else {
+            return nullptr;
+        }
+        string.append(*literalsIt++);
+    }
+    return fg->generator()->stringPool().pool(string);
+}
+
 Value* ASTInterpolationLiteral::generate(FunctionCodeGenerator *fg) const {
-    int64_t length = 0;
+    if (auto constant = generateConstant(fg)) {
+        return constant;
+    }
+
+    int64_t literalsSize = 0;
     for (auto &literal : literals_) {
-        length += literal.size() + 6;
+        literalsSize += utf8(literal).size();
     }
+
+    // All values are converted first so that the builder can be created with exactly the required capacity.
+    auto stringType = fg->compiler()->sString->type();
+    std::vector<llvm::Value *> strings;
+    llvm::Value *size = fg->int64(literalsSize);
+    for (auto &value : values_) {
+        auto str = isString(value->expressionType(), fg->compiler()) ? value->generate(fg) :
+                CallCodeGenerator(fg, CallType::DynamicProtocolDispatch).generate(value->generate(fg),
+                                                                                  value->expressionType(),
+                                                                                  ASTArguments(position()),
+                                                                                  toString_, nullptr);
+        auto strSize = CallCodeGenerator(fg, CallType::StaticDispatch).generate(str, stringType,
+                                                                               ASTArguments(position()), size_,
+                                                                               nullptr);
+        size = fg->builder().CreateAdd(size, strSize);
+        strings.emplace_back(str);
+    }
+
     auto type = init_->owner()->type();
-    auto lengthNode = std::make_shared<ASTNumberLiteral>(length, U"", position());
-    auto builder = ASTInitialization::initObject(fg, ASTArguments(position(), {lengthNode}), init_, type, nullptr, true,
-                                                 nullptr);
+    auto builder = ASTInitialization::initObject(fg, ASTArguments(position()), init_, type, nullptr, true, nullptr,
+                                                 { size });
 
     auto literalsIt = literals_.begin();
     append(fg, *literalsIt++, builder);
-    for (auto &value : values_) {
-        auto str = CallCodeGenerator(fg, CallType::DynamicProtocolDispatch).generate(value->generate(fg), value->expressionType(),
-                                                                 ASTArguments(position()), toString_, nullptr);
-        append(fg, str, builder);
+    for (size_t i = 0; i < values_.size(); i++) {
+        append(fg, strings[i], builder);
+        if (!isString(values_[i]->expressionType(), fg->compiler())) {
+            fg->release(strings[i], stringType);
+        }
         append(fg, *literalsIt++, builder);
     }
 
+    // The builder’s buffer is handed over to the string, which is therefore not copied.
     auto str = CallCodeGenerator(fg, CallType::StaticDispatch).generate(builder, type,
                                                                         ASTArguments(position()), get_, nullptr);
     fg->release(builder, type);
@@ -22,6 +22,9 @@ class ASTUnary : public ASTExpr {
 public:
     ASTUnary(std::shared_ptr<ASTExpr> value, const SourcePosition &p) : ASTExpr(p), expr_(std::move(value)) {}
 
+    /// The expression on whose value this expression operates.
+    const std::shared_ptr<ASTExpr>& expr() const { return expr_; }
+
 protected:
     std::shared_ptr<ASTExpr> expr_;
 };
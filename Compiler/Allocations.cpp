@@ -0,0 +1,73 @@
+#include "Allocations.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace EmojicodeCompiler {
+
+/// Constant-initialized, so that they can be used by allocations made during static initialization.
+static std::atomic<bool> counting(false);
+static std::atomic<size_t> allocations(0);
+
+void startCountingAllocations() {
+    counting.store(true, std::memory_order_relaxed);
+}
+
+size_t allocationCount() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+static void* allocate(size_t size) noexcept {
+    if (counting.load(std::memory_order_relaxed)) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+}  // namespace EmojicodeCompiler
+
+// The replacements only count allocations and otherwise behave like the default operators. The aligned variants are
+// not replaced as the default ones neither use these operators nor are they used for memory from these.
+
+void* operator new(size_t size) {
+    if (auto pointer = EmojicodeCompiler::allocate(size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t &) noexcept {
+    return EmojicodeCompiler::allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t &) noexcept {
+    return EmojicodeCompiler::allocate(size);
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept {
+    std::free(pointer);
+}
@@ -0,0 +1,18 @@
+#ifndef EMOJICODE_ALLOCATIONS_HPP
+#define EMOJICODE_ALLOCATIONS_HPP
+
+#include <cstddef>
+
+namespace EmojicodeCompiler {
+
+/// Starts counting the allocations made with the global operator new. Counting is off by default because all threads
+/// would otherwise contend for the counter on every allocation.
+void startCountingAllocations();
+
+/// @returns The number of allocations made with the global operator new by all threads since
+/// startCountingAllocations() was called. This includes the allocations made by LLVM.
+size_t allocationCount();
+
+}  // namespace EmojicodeCompiler
+
+#endif //EMOJICODE_ALLOCATIONS_HPP
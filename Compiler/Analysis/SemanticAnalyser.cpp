@@ -14,6 +14,9 @@
 #include "Types/Protocol.hpp"
 #include "Types/TypeDefinition.hpp"
 #include "Types/ValueType.hpp"
+#include <exception>
+#include <map>
+#include <thread>
 
 namespace EmojicodeCompiler {
 
@@ -87,17 +90,83 @@ void SemanticAnalyser::checkStartFlagFunction(bool executable) {
 }
 
 void SemanticAnalyser::analyseQueue() {
+    if (compiler()->analysisJobs() > 1) {
+        analyseQueueConcurrently(compiler()->analysisJobs());
+        return;
+    }
     while (!queue_.empty()) {
-        try {
-            FunctionAnalyser(queue_.front(), this).analyse();
-        }
-        catch (CompilerError &ce) {
-            package_->compiler()->error(ce);
-        }
+        analyseFunction(queue_.front());
         queue_.pop();
     }
 }
 
+void SemanticAnalyser::analyseFunction(Function *function) {
+    try {
+        FunctionAnalyser(function, this).analyse();
+    }
+    catch (CompilerError &ce) {
+        package_->compiler()->error(ce);
+    }
+}
+
+void SemanticAnalyser::analyseQueueConcurrently(unsigned jobs) {
+    // The queue is first in, first out, so the n-th function taken from it is the n-th function enqueued.
+    std::map<size_t, std::vector<Compiler::Diagnostic>> diagnostics;
+    size_t taken = 0;
+    unsigned busy = 0;
+    std::exception_ptr exception;
+
+    auto work = [&] {
+        std::unique_lock<std::mutex> lock(queueMutex_);
+        while (true) {
+            // A busy thread might still enqueue functions.
+            queueCondition_.wait(lock, [&] { return !queue_.empty() || busy == 0 || exception != nullptr; });
+            if (queue_.empty() || exception != nullptr) {
+                queueCondition_.notify_all();
+                return;
+            }
+            auto function = queue_.front();
+            queue_.pop();
+            auto index = taken++;
+            busy++;
+            lock.unlock();
+
+            std::vector<Compiler::Diagnostic> collected;
+            std::exception_ptr thrown;
+            try {
+                collected = compiler()->collectDiagnostics([this, function] { analyseFunction(function); });
+            }
+            catch (...) {
+                thrown = std::current_exception();
+            }
+
+            lock.lock();
+            diagnostics.emplace(index, std::move(collected));
+            if (thrown != nullptr && exception == nullptr) {
+                exception = thrown;
+            }
+            busy--;
+            queueCondition_.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < jobs; i++) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    if (exception != nullptr) {
+        std::rethrow_exception(exception);
+    }
+    for (auto &pair : diagnostics) {
+        compiler()->issueDiagnostics(pair.second);
+    }
+}
+
 void SemanticAnalyser::enqueueFunctionsOfTypeDefinition(TypeDefinition *typeDef) {
     typeDef->eachFunction([this](Function *function) {
         enqueueFunction(function);
@@ -105,9 +174,14 @@ void SemanticAnalyser::enqueueFunctionsOfTypeDefinition(TypeDefinition *typeDef)
 }
 
 void SemanticAnalyser::enqueueFunction(Function *function) {
-    analyseFunctionDeclaration(function);
+    {
+        std::lock_guard<std::mutex> lock(declarationMutex_);
+        analyseFunctionDeclaration(function);
+    }
     if (!function->isExternal()) {
+        std::lock_guard<std::mutex> lock(queueMutex_);
         queue_.emplace(function);
+        queueCondition_.notify_one();
     }
 }
 
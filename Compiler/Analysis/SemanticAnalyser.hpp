@@ -5,8 +5,10 @@
 #ifndef EMOJICODE_SEMANTICANALYSER_HPP
 #define EMOJICODE_SEMANTICANALYSER_HPP
 
+#include <condition_variable>
 #include <queue>
 #include <memory>
+#include <mutex>
 
 namespace EmojicodeCompiler {
 
@@ -32,6 +34,7 @@ public:
     /// flag function be present.
     void analyse(bool executable);
 
+    /// Analyses the declaration of the function and enqueues its body for analysis. Thread-safe.
     void enqueueFunction(Function *);
 
     /// Iff `type` is a literal type, returns the default inferred type for the literal type. Otherwise the type is
@@ -51,6 +54,10 @@ public:
 
 private:
     void analyseQueue();
+    /// Analyses the enqueued function bodies on `jobs` threads. The errors and warnings of each body are issued in the
+    /// order in which the bodies were enqueued, which is the order in which analyseQueue() issues them.
+    void analyseQueueConcurrently(unsigned jobs);
+    void analyseFunction(Function *function);
     void enqueueFunctionsOfTypeDefinition(TypeDefinition *typeDef);
     void finalizeProtocols(const Type &type);
     void checkProtocolConformance(const Type &type);
@@ -59,6 +66,11 @@ private:
 
     Package *package_;
     std::queue<Function *> queue_;
+    std::mutex queueMutex_;
+    std::condition_variable queueCondition_;
+    /// Serializes analyseFunctionDeclaration() for functions, e.g. boxing layers, that are enqueued while bodies are
+    /// analysed concurrently. A mutex of its own is needed as analysing a declaration may request reifications.
+    std::mutex declarationMutex_;
     bool imported_;
 
     bool checkArgumentPromise(const Function *sub, const Function *super, const TypeContext &subContext,
@@ -0,0 +1,96 @@
+//
+//  CompilationCache.cpp
+//  EmojicodeCompiler
+//
+
+#include "CompilationCache.hpp"
+#include "Compiler.hpp"
+#include "Options.hpp"
+#include "Package/Package.hpp"
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <fstream>
+
+namespace EmojicodeCompiler {
+
+namespace CLI {
+
+CompilationCache::CompilationCache(std::string directory, const Options &options)
+        : outputs_(options.outputPaths()), linkTimeOptimize_(options.lto()), standalone_(options.standalone()) {
+    llvm::MD5 md5;
+    md5.update(options.fingerprint());
+    llvm::MD5::MD5Result result;
+    md5.final(result);
+    entry_ = std::move(directory) + "/" + result.digest().str().str();
+}
+
+std::string CompilationCache::hashFile(const std::string &path) {
+    auto buffer = llvm::MemoryBuffer::getFile(path);
+    if (!buffer) {
+        return "-";
+    }
+    llvm::MD5 md5;
+    md5.update((*buffer)->getBuffer());
+    llvm::MD5::MD5Result result;
+    md5.final(result);
+    return result.digest().str().str();
+}
+
+bool CompilationCache::restore() const {
+    std::ifstream manifest(manifestPath());
+    if (manifest.fail()) {
+        return false;
+    }
+
+    std::string hash, path;
+    while (manifest >> hash && std::getline(manifest >> std::ws, path)) {
+        if (hashFile(path) != hash) {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < outputs_.size(); i++) {
+        if (llvm::sys::fs::copy_file(storedOutputPath(i), outputs_[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CompilationCache::store(Compiler *compiler) const {
+    auto inputs = compiler->sourceManager().paths();
+    for (auto package : compiler->importedPackages()) {
+        inputs.emplace_back(compiler->findBinaryPathPackage(package->path(), package->name()));
+        if (linkTimeOptimize_) {
+            inputs.emplace_back(compiler->findBitcodePathPackage(package->path(), package->name()));
+        }
+    }
+    if (standalone_) {
+        inputs.emplace_back(compiler->findRuntimeLibrary());
+    }
+
+    // The manifest is removed first and written last so that an entry is never used while it is incomplete.
+    llvm::sys::fs::remove(manifestPath());
+    if (llvm::sys::fs::create_directories(entry_)) {
+        return;
+    }
+    for (size_t i = 0; i < outputs_.size(); i++) {
+        if (llvm::sys::fs::copy_file(outputs_[i], storedOutputPath(i))) {
+            return;
+        }
+    }
+
+    std::ofstream manifest(manifestPath() + ".tmp");
+    for (auto &input : inputs) {
+        manifest << hashFile(input) << " " << input << "\n";
+    }
+    manifest.close();
+    if (!manifest.fail()) {
+        llvm::sys::fs::rename(manifestPath() + ".tmp", manifestPath());
+    }
+}
+
+}  // namespace CLI
+
+}  // namespace EmojicodeCompiler
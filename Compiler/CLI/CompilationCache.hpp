@@ -0,0 +1,60 @@
+//
+//  CompilationCache.hpp
+//  EmojicodeCompiler
+//
+
+#ifndef CompilationCache_hpp
+#define CompilationCache_hpp
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace EmojicodeCompiler {
+
+class Compiler;
+
+namespace CLI {
+
+class Options;
+
+/// A directory that stores the results of previous compilations.
+///
+/// Each entry belongs to one compiler executable and one set of command-line options, see Options::fingerprint(),
+/// and records a hash of every file that influenced the result, i.e. the source files of the main package, the
+/// interfaces of all imported packages and the archives and bitcode files that were linked. If none of these files
+/// changed, the outputs of the compilation are copied from the cache and the compiler does not parse, analyse or
+/// generate anything.
+class CompilationCache {
+public:
+    /// @param directory The cache directory. It is created if it does not exist.
+    CompilationCache(std::string directory, const Options &options);
+
+    /// Copies the outputs of a previous compilation with the same options and inputs to their destinations.
+    /// @returns True if the outputs were restored, false if the package must be compiled.
+    bool restore() const;
+
+    /// Stores the outputs of the successful compilation performed by `compiler`.
+    void store(Compiler *compiler) const;
+
+private:
+    /// The directory of the entry for the options with which the cache was created.
+    std::string entry_;
+    /// The paths of all files that the compiler produces with these options.
+    std::vector<std::string> outputs_;
+    bool linkTimeOptimize_;
+    bool standalone_;
+
+    std::string manifestPath() const { return entry_ + "/manifest"; }
+    std::string storedOutputPath(size_t index) const { return entry_ + "/" + std::to_string(index); }
+
+    /// @returns The hex encoded MD5 hash of the file’s contents or "-" if the file cannot be read. Optional inputs,
+    /// like bitcode files, therefore invalidate the entry once they appear.
+    static std::string hashFile(const std::string &path);
+};
+
+}  // namespace CLI
+
+}  // namespace EmojicodeCompiler
+
+#endif /* CompilationCache_hpp */
@@ -10,6 +10,7 @@
 #include "Lex/SourcePosition.hpp"
 #include "Utils/rang.hpp"
 #include "CompilerError.hpp"
+#include <iomanip>
 
 namespace EmojicodeCompiler {
 
@@ -53,12 +54,26 @@ void HRFCompilerDelegate::warn(Compiler *compiler, const std::string &message, c
     printOffendingCode(compiler, p);
 }
 
+void HRFCompilerDelegate::timings(Compiler *compiler, const std::vector<Timing> &timings) {
+    std::cerr << rang::style::bold << "⏱  " << std::left << std::setw(9) << "category" << std::setw(24) << "name"
+              << std::right << std::setw(10) << "wall (s)" << std::setw(10) << "cpu (s)" << std::setw(14)
+              << "peak rss (MB)" << std::setw(13) << "allocations" << rang::style::reset << std::endl;
+    std::cerr << std::fixed << std::setprecision(3);
+    for (auto &timing : timings) {
+        std::cerr << "   " << std::left << std::setw(9) << timing.category << std::setw(24) << timing.name
+                  << std::right << std::setw(10) << timing.wall << std::setw(10) << timing.cpu << std::setw(14)
+                  << std::setprecision(1) << timing.peakRss / (1024.0 * 1024.0) << std::setprecision(3)
+                  << std::setw(13) << timing.allocations << std::endl;
+    }
+    std::cerr << std::defaultfloat << std::left;
+}
+
 void HRFCompilerDelegate::printOffendingCode(Compiler *compiler, const SourcePosition &position) {
     auto line = position.wholeLine();
     if (line.empty()) {
         return;
     }
-    std::cerr << utf8(line);
+    std::cerr << line;
     auto r = position.character > 0 ? position.character - 1 : 0;
     std::cerr << std::string(r, ' ') << "⬆️" << std::endl << std::endl;
 }
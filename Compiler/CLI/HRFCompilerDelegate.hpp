@@ -23,6 +23,8 @@ public:
     void begin() override {}
     void error(Compiler *compiler, const CompilerError &ce) override;
     void warn(Compiler *compiler, const std::string &message, const SourcePosition &p) override;
+    /// Prints the timings as a table.
+    void timings(Compiler *compiler, const std::vector<Timing> &timings) override;
     void finish() override {}
 
 private:
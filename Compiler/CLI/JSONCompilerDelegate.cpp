@@ -48,6 +48,27 @@ void JSONCompilerDelegate::warn(Compiler *compiler, const std::string &message,
     printJson("warning", p, message);
 }
 
+void JSONCompilerDelegate::timings(Compiler *compiler, const std::vector<Timing> &timings) {
+    for (auto &timing : timings) {
+        writer_.StartObject();
+        writer_.Key("type");
+        writer_.String("timing");
+        writer_.Key("category");
+        writer_.String(timing.category);
+        writer_.Key("name");
+        writer_.String(timing.name);
+        writer_.Key("wall");
+        writer_.Double(timing.wall);
+        writer_.Key("cpu");
+        writer_.Double(timing.cpu);
+        writer_.Key("peakRss");
+        writer_.Uint64(timing.peakRss);
+        writer_.Key("allocations");
+        writer_.Uint64(timing.allocations);
+        writer_.EndObject();
+    }
+}
+
 }  // namespace CLI
 
 }  // namespace EmojicodeCompiler
@@ -26,6 +26,8 @@ public:
     void begin() override;
     void error(Compiler *compiler, const CompilerError &ce) override;
     void warn(Compiler *compiler, const std::string &message, const SourcePosition &p) override;
+    /// Prints an object of type `timing` for every timing.
+    void timings(Compiler *compiler, const std::vector<Timing> &timings) override;
     void finish() override;
 private:
     rapidjson::OStreamWrapper wrapper_;
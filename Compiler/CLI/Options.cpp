@@ -9,10 +9,15 @@
 #include "Options.hpp"
 #include "HRFCompilerDelegate.hpp"
 #include "JSONCompilerDelegate.hpp"
+#include "Lex/TokenCache.hpp"
 #include "Utils/StringUtils.hpp"
 #include "Utils/args.hxx"
+#include <llvm/ADT/StringMap.h>
+#include <llvm/MC/SubtargetFeature.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Host.h>
 #include <llvm/Support/Path.h>
+#include <llvm/Support/Threading.h>
 #include <iostream>
 
 namespace EmojicodeCompiler {
@@ -38,6 +43,25 @@ Options::Options(int argc, char *argv[]) {
     args::Flag color(parser, "color", "Always show compiler messages in color", {"color"});
     args::Flag optimize(parser, "optimize", "Compile with optimizations", {'O'});
     args::Flag printIr(parser, "emit-llvm", "Print the IR to the standard output", {"emit-llvm"});
+    args::Flag lto(parser, "lto", "Emit and link LLVM bitcode for link-time optimization across packages", {"lto"});
+    args::Flag timePhases(parser, "time-phases", "Report the time, memory and allocations of each phase, package and "
+                          "pass group", {"time-phases"});
+    args::ValueFlag<unsigned> jobs(parser, "jobs", "Emit machine code on the given number of threads (0 for one per "
+                                   "core)", {'j', "jobs"});
+    args::ValueFlag<unsigned> analysisJobs(parser, "analysis-jobs", "Experimental: Analyse function bodies on the "
+                                           "given number of threads (0 for one per core)", {"analysis-jobs"});
+    args::ValueFlag<std::string> cache(parser, "cache", "Reuse the outputs of previous compilations stored in the "
+                                       "given directory if no input changed", {"cache"});
+    args::ValueFlag<std::string> targetCpu(parser, "cpu", "Generate code for the given CPU, e.g. haswell, or for the "
+                                           "host CPU if native", {"target-cpu"});
+    args::ValueFlag<std::string> targetFeatures(parser, "features", "Enable or disable target features, e.g. "
+                                                "+avx2,-fma, or enable the features of the host CPU if native",
+                                                {"target-features"});
+    args::ValueFlag<std::string> linker(parser, "linker", "Link with the given C++ compiler driver instead of $CXX or "
+                                        "c++", {"linker"});
+    args::ValueFlagList<std::string> linkArgs(parser, "argument", "Passes the argument to the C++ compiler driver "
+                                              "when linking, e.g. -fuse-ld=lld or -Wl,--gc-sections",
+                                              {"link-arg"});
     args::ValueFlagList<std::string> searchPaths(parser, "search path",
                                                  "Adds the path to the package search path (after './packages')",
                                                  {'S'});
@@ -54,6 +78,14 @@ Options::Options(int argc, char *argv[]) {
         forceColor_ = color.Get();
         optimize_ = optimize.Get();
         printIr_ = printIr.Get();
+        lto_ = lto.Get();
+        timePhases_ = timePhases.Get();
+        if (jobs) {
+            jobs_ = jobs.Get() == 0 ? llvm::heavyweight_hardware_concurrency() : jobs.Get();
+        }
+        if (analysisJobs) {
+            analysisJobs_ = analysisJobs.Get() == 0 ? llvm::heavyweight_hardware_concurrency() : analysisJobs.Get();
+        }
 
         if (package) {
             mainPackageName_ = package.Get();
@@ -67,6 +99,14 @@ Options::Options(int argc, char *argv[]) {
         if (interfaceOut) {
             interfaceFile_ = interfaceOut.Get();
         }
+        if (linker) {
+            linker_ = linker.Get();
+        }
+        linkerArguments_ = linkArgs.Get();
+        if (cache && !format_) {
+            cacheDirectory_ = cache.Get();
+        }
+        configureTarget(targetCpu.Get(), targetFeatures.Get());
     }
     catch (args::Help &e) {
         std::cout << parser;
@@ -83,6 +123,61 @@ Options::Options(int argc, char *argv[]) {
     }
 
     configureOutPath();
+    createFingerprint(argc, argv);
+}
+
+void Options::configureTarget(const std::string &cpu, const std::string &features) {
+    if (cpu == "native") {
+        targetCpu_ = llvm::sys::getHostCPUName();
+    }
+    else if (!cpu.empty()) {
+        targetCpu_ = cpu;
+    }
+
+    if (features != "native") {
+        targetFeatures_ = features;
+        return;
+    }
+    llvm::StringMap<bool> hostFeatures;
+    if (llvm::sys::getHostCPUFeatures(hostFeatures)) {
+        llvm::SubtargetFeatures subtargetFeatures;
+        for (auto &feature : hostFeatures) {
+            subtargetFeatures.AddFeature(feature.first(), feature.second);
+        }
+        targetFeatures_ = subtargetFeatures.getString();
+    }
+}
+
+/// @returns The path of the running compiler executable.
+static std::string executablePath(const char *argv0) {
+    return llvm::sys::fs::getMainExecutable(argv0, reinterpret_cast<void *>(&executablePath));
+}
+
+void Options::createFingerprint(int argc, char *argv[]) {
+    // Outputs of a different or rebuilt compiler must not be reused, so the executable is identified by its path,
+    // size and modification time.
+    auto executable = executablePath(argv[0]);
+    llvm::sys::fs::file_status executableStatus;
+    fingerprint_.append(executable).push_back('\0');
+    if (!llvm::sys::fs::status(executable, executableStatus)) {
+        fingerprint_.append(std::to_string(executableStatus.getSize())).push_back('\0');
+        auto modified = executableStatus.getLastModificationTime().time_since_epoch().count();
+        fingerprint_.append(std::to_string(modified)).push_back('\0');
+    }
+
+    llvm::SmallString<128> workingDirectory;
+    llvm::sys::fs::current_path(workingDirectory);
+    fingerprint_.append(workingDirectory.c_str()).push_back('\0');
+    for (int i = 1; i < argc; i++) {
+        fingerprint_.append(argv[i]).push_back('\0');
+    }
+    for (auto &path : packageSearchPaths_) {
+        fingerprint_.append(path).push_back('\0');
+    }
+    // The host CPU might have changed if native was requested.
+    fingerprint_.append(targetCpu_).push_back('\0');
+    fingerprint_.append(targetFeatures_).push_back('\0');
+    fingerprint_.append(linker());
 }
 
 void Options::readEnvironment(const std::vector<std::string> &searchPaths) {
@@ -136,19 +231,15 @@ std::unique_ptr<CompilerDelegate> Options::compilerDelegate() const {
 }
 
 std::string Options::linker() const {
+    if (!linker_.empty()) {
+        return linker_;
+    }
     if (auto var = getenv("CXX")) {
         return var;
     }
     return "c++";
 }
 
-std::string Options::ar() const {
-    if (auto var = getenv("AR")) {
-        return var;
-    }
-    return "ar";
-}
-
 std::string Options::objectPath() const {
     if (!pack() && !outPath_.empty()) {
         return outPath_;
@@ -156,6 +247,32 @@ std::string Options::objectPath() const {
     return outDir_ + std::string(llvm::sys::path::stem(mainFile_)) + ".o";
 }
 
+std::string Options::bitcodePath() const {
+    if (!lto_ || standalone()) {
+        return "";
+    }
+    return outDir_ + "lib" + mainPackageName_ + ".bc";
+}
+
+std::vector<std::string> Options::outputPaths() const {
+    std::vector<std::string> paths;
+    if (!llvmIrPath().empty()) {
+        paths.emplace_back(llvmIrPath());
+    }
+    else {
+        paths.emplace_back(pack() ? outPath() : objectPath());
+    }
+    for (auto &path : { interfaceFile_, bitcodePath(), reportPath_ }) {
+        if (!path.empty()) {
+            paths.emplace_back(path);
+        }
+    }
+    if (!interfaceFile_.empty()) {
+        paths.emplace_back(tokenCachePath(interfaceFile_));
+    }
+    return paths;
+}
+
 std::string Options::llvmIrPath() const {
     if (!printIr_) {
         return "";
@@ -40,7 +40,20 @@ public:
     bool shouldReport() const { return report_; }
     bool optimize() const { return optimize_; }
     bool pack() const { return pack_; }
+    /// Whether link-time optimization was requested. Packages then additionally emit bitcode and standalone
+    /// executables link the bitcode of all imported packages that provide it before optimization.
+    bool lto() const { return lto_; }
     bool standalone() const { return mainPackageName_ == "_"; }
+    /// The CPU for which code is generated. `native` has already been replaced with the name of the host CPU.
+    const std::string& targetCpu() const { return targetCpu_; }
+    /// The target features, e.g. `+avx2,-fma`, that are enabled or disabled in addition to those of the CPU.
+    const std::string& targetFeatures() const { return targetFeatures_; }
+    /// Whether the time and memory spent in each phase, imported package and LLVM pass group shall be reported.
+    bool timePhases() const { return timePhases_; }
+    /// The number of threads that shall emit machine code in parallel.
+    unsigned jobs() const { return jobs_; }
+    /// The number of threads on which function bodies shall be analysed concurrently.
+    unsigned analysisJobs() const { return analysisJobs_; }
 
     const std::string& outPath() const { return outPath_; }
     const std::string& mainFile() const { return mainFile_; }
@@ -48,9 +61,23 @@ public:
     const std::vector<std::string>& packageSearchPaths() const { return packageSearchPaths_; }
     const std::string& mainPackageName() const { return mainPackageName_; }
     const std::string& reportPath() const { return reportPath_; }
+    /// The directory of the CompilationCache or an empty string if no cache shall be used.
+    const std::string& cacheDirectory() const { return cacheDirectory_; }
+    /// A string that identifies the invocation of the compiler. It contains the path, size and modification time of
+    /// the compiler executable, all command-line arguments, the working directory and all environment variables the
+    /// compiler uses.
+    const std::string& fingerprint() const { return fingerprint_; }
+    /// @returns The paths of all files that the compiler produces when invoked with these options.
+    std::vector<std::string> outputPaths() const;
     std::string llvmIrPath() const;
+    /// The path at which the bitcode of the main package is placed or an empty string if no bitcode is to be emitted.
+    std::string bitcodePath() const;
+    /// The C++ compiler driver used to link executables and to combine partial object files. This is the command given
+    /// with --linker, $CXX or `c++`. Like $CXX, it may contain leading arguments separated by whitespace, e.g.
+    /// `ccache clang++`.
     std::string linker() const;
-    std::string ar() const;
+    /// The arguments given with --link-arg, which are passed to the linker() when linking an executable.
+    const std::vector<std::string>& linkerArguments() const { return linkerArguments_; }
 
     /// Whether the main purpose of the invocation of the compiler is to prettyprint a file.
     /// This method returns true if prettyprint was explicitely requested or if a file is being migrated.
@@ -62,7 +89,13 @@ private:
     std::string mainFile_;
     std::string interfaceFile_;
     std::string reportPath_;
+    std::string cacheDirectory_;
+    std::string fingerprint_;
+    std::string targetCpu_ = "generic";
+    std::string targetFeatures_;
     std::string llvmIr_;
+    std::string linker_;
+    std::vector<std::string> linkerArguments_;
     std::vector<std::string> packageSearchPaths_;
     std::string mainPackageName_ = "_";
     /// Path to the directory where the output files will be placed.
@@ -74,9 +107,17 @@ private:
     bool forceColor_ = false;
     bool optimize_ = false;
     bool printIr_ = false;
+    bool lto_ = false;
+    bool timePhases_ = false;
+    unsigned jobs_ = 1;
+    unsigned analysisJobs_ = 1;
 
     void readEnvironment(const std::vector<std::string> &searchPaths);
 
+    void createFingerprint(int argc, char *argv[]);
+
+    void configureTarget(const std::string &cpu, const std::string &features);
+
     void configureOutPath();
 };
 
@@ -0,0 +1,276 @@
+#include "Server.hpp"
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+
+extern char **environ;
+
+namespace EmojicodeCompiler {
+
+namespace CLI {
+
+/// Precedes every request. It is sent together with the standard input, output and error file descriptors of the
+/// client and is followed by `size` bytes: the working directory, `argc` arguments and `envc` environment variables,
+/// each terminated by a null byte. The server answers with the exit status as int32_t.
+struct RequestHeader {
+    uint32_t argc;
+    uint32_t envc;
+    uint32_t size;
+};
+
+/// Sent instead of an exit status if the server refuses a request, in which case the client compiles by itself.
+static const int32_t kRejected = -1;
+
+static bool socketAddress(const std::string &path, sockaddr_un *address) {
+    if (path.size() >= sizeof(address->sun_path)) {
+        return false;
+    }
+    std::memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+    std::memcpy(address->sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+static bool writeAll(int fd, const void *data, size_t size) {
+    auto bytes = static_cast<const char *>(data);
+    while (size > 0) {
+        auto written = write(fd, bytes, size);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return false;
+        }
+        bytes += written;
+        size -= written;
+    }
+    return true;
+}
+
+static bool readAll(int fd, void *data, size_t size) {
+    auto bytes = static_cast<char *>(data);
+    while (size > 0) {
+        auto r = read(fd, bytes, size);
+        if (r < 0 && errno == EINTR) {
+            continue;
+        }
+        if (r <= 0) {
+            return false;
+        }
+        bytes += r;
+        size -= r;
+    }
+    return true;
+}
+
+/// @returns True if the client at the other end of `connection` runs as the same user as the server. Compilations
+/// read and write arbitrary files and run the linker, so other users must not be able to request them.
+static bool isSameUser(int connection) {
+#ifdef __linux__
+    ucred credentials{};
+    socklen_t size = sizeof(credentials);
+    if (getsockopt(connection, SOL_SOCKET, SO_PEERCRED, &credentials, &size) != 0) {
+        return false;
+    }
+    return credentials.uid == geteuid();
+#else
+    uid_t uid;
+    gid_t gid;
+    if (getpeereid(connection, &uid, &gid) != 0) {
+        return false;
+    }
+    return uid == geteuid();
+#endif
+}
+
+[[noreturn]] static void fail(const char *what) {
+    std::cerr << "💣 Compile server: " << what << ": " << std::strerror(errno) << std::endl;
+    std::exit(1);
+}
+
+/// Handles the request on `connection` in the child process.
+[[noreturn]] static void handleRequest(int connection, CompileFunction compile) {
+    // The compilation waits for the linker it runs, which must not be reaped automatically.
+    std::signal(SIGCHLD, SIG_DFL);
+    std::signal(SIGPIPE, SIG_DFL);
+
+    RequestHeader header{};
+    iovec iov { &header, sizeof(header) };
+    char control[CMSG_SPACE(3 * sizeof(int))];
+    msghdr message{};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    if (recvmsg(connection, &message, MSG_WAITALL) != sizeof(header)) {
+        _exit(1);
+    }
+    auto cmsg = CMSG_FIRSTHDR(&message);
+    if (cmsg == nullptr || cmsg->cmsg_type != SCM_RIGHTS || cmsg->cmsg_len != CMSG_LEN(3 * sizeof(int))) {
+        _exit(1);
+    }
+    int fds[3];
+    std::memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+
+    std::vector<char> payload(header.size);
+    if (!readAll(connection, payload.data(), payload.size()) || payload.empty() || payload.back() != '\0') {
+        _exit(1);
+    }
+    std::vector<char *> strings;
+    for (size_t i = 0; i < payload.size(); i += std::strlen(&payload[i]) + 1) {
+        strings.emplace_back(&payload[i]);
+    }
+    if (strings.size() != 1 + header.argc + header.envc || chdir(strings[0]) != 0) {
+        _exit(1);
+    }
+    std::vector<char *> argv(strings.begin() + 1, strings.begin() + 1 + header.argc);
+    argv.emplace_back(nullptr);
+    std::vector<char *> env(strings.begin() + 1 + header.argc, strings.end());
+    env.emplace_back(nullptr);
+    environ = env.data();
+
+    for (int i = 0; i < 3; i++) {
+        dup2(fds[i], i);
+        close(fds[i]);
+    }
+
+    int32_t status = compile(static_cast<int>(header.argc), argv.data());
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+    writeAll(connection, &status, sizeof(status));
+    _exit(status);
+}
+
+void runServer(const std::string &path, CompileFunction compile) {
+    sockaddr_un address{};
+    if (!socketAddress(path, &address)) {
+        errno = ENAMETOOLONG;
+        fail(path.c_str());
+    }
+    auto server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0) {
+        fail("socket");
+    }
+    // Removes the socket of a previous server.
+    unlink(path.c_str());
+    if (bind(server, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+        fail(path.c_str());
+    }
+    if (listen(server, SOMAXCONN) != 0) {
+        fail("listen");
+    }
+
+    // The children need not be waited for.
+    std::signal(SIGCHLD, SIG_IGN);
+    // A client that went away must not terminate the server.
+    std::signal(SIGPIPE, SIG_IGN);
+    while (true) {
+        auto connection = accept(server, nullptr, nullptr);
+        if (connection < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            fail("accept");
+        }
+        if (!isSameUser(connection)) {
+            std::cerr << "💣 Compile server: Rejected a request from another user." << std::endl;
+            writeAll(connection, &kRejected, sizeof(kRejected));
+            close(connection);
+            continue;
+        }
+        auto pid = fork();
+        if (pid == 0) {
+            close(server);
+            handleRequest(connection, compile);
+        }
+        if (pid < 0) {
+            std::cerr << "💣 Compile server: fork: " << std::strerror(errno) << std::endl;
+        }
+        close(connection);
+    }
+}
+
+bool compileOnServer(const std::string &path, int argc, char *argv[], int *status) {
+    sockaddr_un address{};
+    if (!socketAddress(path, &address)) {
+        return false;
+    }
+    auto connection = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (connection < 0) {
+        return false;
+    }
+    if (connect(connection, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+        close(connection);
+        return false;
+    }
+
+    std::vector<char> payload;
+    auto append = [&payload](const char *string) {
+        payload.insert(payload.end(), string, string + std::strlen(string) + 1);
+    };
+    std::vector<char> workingDirectory(4096);
+    if (getcwd(workingDirectory.data(), workingDirectory.size()) == nullptr) {
+        close(connection);
+        return false;
+    }
+    append(workingDirectory.data());
+    for (int i = 0; i < argc; i++) {
+        append(argv[i]);
+    }
+    uint32_t envc = 0;
+    for (auto var = environ; *var != nullptr; var++, envc++) {
+        append(*var);
+    }
+
+    RequestHeader header { static_cast<uint32_t>(argc), envc, static_cast<uint32_t>(payload.size()) };
+    iovec iov { &header, sizeof(header) };
+    char control[CMSG_SPACE(3 * sizeof(int))];
+    std::memset(control, 0, sizeof(control));
+    msghdr message{};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    auto cmsg = CMSG_FIRSTHDR(&message);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(3 * sizeof(int));
+    int fds[3] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+    std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    // A server that rejects the request closes the connection, which must not terminate this process.
+    auto previousHandler = std::signal(SIGPIPE, SIG_IGN);
+    auto sent = sendmsg(connection, &message, 0) == sizeof(header) &&
+                writeAll(connection, payload.data(), payload.size());
+    std::signal(SIGPIPE, previousHandler);
+    if (!sent) {
+        close(connection);
+        return false;
+    }
+
+    int32_t result;
+    if (!readAll(connection, &result, sizeof(result))) {
+        // The server is gone if the child crashed, which is reported like a crash of the compiler.
+        result = 70;
+    }
+    close(connection);
+    if (result == kRejected) {
+        return false;
+    }
+    *status = result;
+    return true;
+}
+
+}  // namespace CLI
+
+}  // namespace EmojicodeCompiler
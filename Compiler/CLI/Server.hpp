@@ -0,0 +1,32 @@
+#ifndef EMOJICODE_SERVER_HPP
+#define EMOJICODE_SERVER_HPP
+
+#include <string>
+
+namespace EmojicodeCompiler {
+
+namespace CLI {
+
+/// The function that performs a compilation with the given command-line arguments and returns the exit status.
+using CompileFunction = int (*)(int argc, char *argv[]);
+
+/// Runs a compile server that listens on the Unix domain socket at `path` until the process is terminated.
+///
+/// The server answers every request in a child process forked from the server, which runs `compile` with the
+/// arguments, working directory, environment and standard streams of the client. All state set up before calling this
+/// function, like the registered LLVM targets, is therefore already available to every compilation, while the
+/// compilations cannot affect each other or the server. Requests from clients that do not run as the same user as the
+/// server are rejected.
+[[noreturn]] void runServer(const std::string &path, CompileFunction compile);
+
+/// Lets the compile server listening at `path` perform the compilation with the given arguments and the working
+/// directory, environment and standard streams of this process.
+/// @param status Set to the exit status of the compilation if the server was reached.
+/// @returns False if no server could be reached, in which case nothing was compiled.
+bool compileOnServer(const std::string &path, int argc, char *argv[], int *status);
+
+}  // namespace CLI
+
+}  // namespace EmojicodeCompiler
+
+#endif //EMOJICODE_SERVER_HPP
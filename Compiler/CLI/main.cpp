@@ -6,11 +6,16 @@
 //  Copyright (c) 2015 Theo Weidmann. All rights reserved.
 //
 
+#include "CompilationCache.hpp"
 #include "Compiler.hpp"
+#include "Generation/CodeGenerator.hpp"
 #include "Options.hpp"
 #include "Package/RecordingPackage.hpp"
 #include "PackageReporter.hpp"
 #include "Prettyprint/PrettyPrinter.hpp"
+#include "Server.hpp"
+#include <cstdlib>
+#include <cstring>
 #include <exception>
 #include <iostream>
 
@@ -22,6 +27,7 @@ class FormatPhase : public Compiler::Phase {
     void perform(Compiler *compiler) override {
         PrettyPrinter(compiler->mainPackage()).print();
     }
+    const char* name() const override { return "format"; }
 };
 
 class ReportPhase : public Compiler::Phase {
@@ -30,6 +36,7 @@ public:
     void perform(Compiler *compiler) override {
         PackageReporter(compiler->mainPackage(), path_).report();
     }
+    const char* name() const override { return "report"; }
 
 private:
     std::string path_;
@@ -38,8 +45,22 @@ private:
 /// The compiler CLI main function
 /// @returns True if the requested operation was successful.
 bool start(const Options &options) {
-    Compiler compiler(options.mainPackageName(), options.mainFile(), options.packageSearchPaths(),
-                      options.compilerDelegate());
+    std::unique_ptr<CompilationCache> cache;
+    if (!options.cacheDirectory().empty()) {
+        cache = std::make_unique<CompilationCache>(options.cacheDirectory(), options);
+        if (cache->restore()) {
+            return true;
+        }
+    }
+
+    // The compiler is deliberately never destroyed. The process exits right after the compilation, and destroying
+    // the packages, their ASTs and the LLVM module would only walk and free memory that is reclaimed at exit anyway.
+    auto &compiler = *new Compiler(options.mainPackageName(), options.mainFile(), options.packageSearchPaths(),
+                                   options.compilerDelegate());
+    compiler.setAnalysisJobs(options.analysisJobs());
+    if (options.timePhases()) {
+        compiler.enableTiming();
+    }
 
     compiler.add<Compiler::ParsePhase>();
     if (options.prettyprint()) {
@@ -50,37 +71,46 @@ bool start(const Options &options) {
     if (!options.interfaceFile().empty()) {
         compiler.add<Compiler::PrintInterfacePhase>(options.interfaceFile());
     }
-    compiler.add<Compiler::GenerationPhase>(options.optimize());
+    compiler.add<Compiler::GenerationPhase>(options.optimize(), options.lto() && options.standalone(),
+                                            options.targetCpu(), options.targetFeatures());
+    if (!options.bitcodePath().empty()) {
+        compiler.add<Compiler::BitcodeEmissionPhase>(options.bitcodePath());
+    }
     if (!options.llvmIrPath().empty()) {
         compiler.add<Compiler::LLVMIREmissionPhase>(options.llvmIrPath());
     }
     else {
-        compiler.add<Compiler::ObjectFileEmissionPhase>(options.objectPath());
+        compiler.add<Compiler::ObjectFileEmissionPhase>(options.objectPath(), options.jobs(), options.linker());
     }
     if (options.pack()) {
         if (options.standalone()) {
-            compiler.add<Compiler::LinkPhase>(options.objectPath(), options.outPath(), options.linker());
+            compiler.add<Compiler::LinkPhase>(options.objectPath(), options.outPath(), options.linker(),
+                                              options.linkerArguments());
         }
         else {
-            compiler.add<Compiler::ArchivePhase>(options.objectPath(), options.outPath(), options.ar());
+            compiler.add<Compiler::ArchivePhase>(options.objectPath(), options.outPath());
         }
     }
 
     if (options.shouldReport()) {
         compiler.add<ReportPhase>(options.reportPath());
     }
-    return compiler.compile();
+    if (!compiler.compile()) {
+        return false;
+    }
+    if (cache != nullptr) {
+        cache->store(&compiler);
+    }
+    return true;
 }
 
-}  // namespace CLI
-
-}  // namespace EmojicodeCompiler
-
-int main(int argc, char *argv[]) {
+/// Compiles according to the command-line arguments.
+/// @returns The exit status.
+int run(int argc, char *argv[]) {
     try {
-        return EmojicodeCompiler::CLI::start(EmojicodeCompiler::CLI::Options(argc, argv)) ? 0 : 1;
+        return start(Options(argc, argv)) ? 0 : 1;
     }
-    catch (EmojicodeCompiler::CLI::CompilationCancellation &e) { return 0; }
+    catch (CompilationCancellation &e) { return 0; }
     catch (std::exception &ex) {
         std::cout << "💣 The compiler crashed due to an internal problem: " << ex.what() << std::endl;
         std::cout << "Please report this message and the code that you were trying to compile as an issue on GitHub.";
@@ -94,3 +124,24 @@ int main(int argc, char *argv[]) {
         return 70;
     }
 }
+
+}  // namespace CLI
+
+}  // namespace EmojicodeCompiler
+
+/// `emojicodec --daemon <socket>` runs a compile server (see EmojicodeCompiler::CLI::runServer()). Any other invocation
+/// is performed by the server at the socket in the environment variable EMOJICODEC_SERVER if it can be reached, and
+/// by this process otherwise.
+int main(int argc, char *argv[]) {
+    if (argc == 3 && std::strcmp(argv[1], "--daemon") == 0) {
+        EmojicodeCompiler::CodeGenerator::initializeTargets();
+        EmojicodeCompiler::CLI::runServer(argv[2], EmojicodeCompiler::CLI::run);
+    }
+    if (auto server = std::getenv("EMOJICODEC_SERVER")) {
+        int status;
+        if (EmojicodeCompiler::CLI::compileOnServer(server, argc, argv, &status)) {
+            return status;
+        }
+    }
+    return EmojicodeCompiler::CLI::run(argc, argv);
+}
@@ -7,13 +7,18 @@
 //
 
 #include "CompilerError.hpp"
+#include "Allocations.hpp"
 #include "Analysis/SemanticAnalyser.hpp"
 #include "Compiler.hpp"
 #include "Generation/CodeGenerator.hpp"
+#include "Lex/TokenCache.hpp"
 #include "Package/RecordingPackage.hpp"
 #include "Parsing/AbstractParser.hpp"
 #include "Prettyprint/PrettyPrinter.hpp"
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Object/ArchiveWriter.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Program.h>
 #include "MemoryFlowAnalysis/MFAnalyser.hpp"
 #include "Types/ValueType.hpp"
 #include "Functions/Function.hpp"
@@ -21,6 +26,25 @@
 
 namespace EmojicodeCompiler {
 
+/// Runs `command` with the given arguments and waits for it to exit. `command` is split at whitespace into the
+/// program, which is searched for in PATH unless it contains a slash, and arguments that precede `arguments`, so that
+/// commands like `ccache c++` or `clang++ -m64`, as commonly found in $CXX, work.
+/// @returns True if the program ran and exited with status 0.
+static bool execute(const std::string &command, const std::vector<std::string> &arguments) {
+    llvm::SmallVector<llvm::StringRef, 4> words;
+    llvm::SplitString(command, words);
+    if (words.empty()) {
+        return false;
+    }
+    auto path = llvm::sys::findProgramByName(words.front());
+    if (!path) {
+        return false;
+    }
+    std::vector<llvm::StringRef> argv(words.begin(), words.end());
+    argv.insert(argv.end(), arguments.begin(), arguments.end());
+    return llvm::sys::ExecuteAndWait(*path, argv) == 0;
+}
+
 Compiler::Compiler(std::string mainPackage, std::string mainFile, std::vector<std::string> pkgSearchPaths,
                    std::unique_ptr<CompilerDelegate> delegate)
         : mainFile_(std::move(mainFile)), packageSearchPaths_(std::move(pkgSearchPaths)),
@@ -33,7 +57,11 @@ bool Compiler::compile() {
     delegate_->begin();
     try {
         for (auto &phase : phases_) {
+            Stopwatch stopwatch(timing_);
+            stopwatch.start();
             phase->perform(this);
+            stopwatch.stop();
+            addTiming(stopwatch.timing("phase", phase->name()));
             if (hasError_) {
                 break;
             }
@@ -42,10 +70,24 @@ bool Compiler::compile() {
     catch (CompilerError &ce) {
         error(ce);
     }
+    if (timing_) {
+        delegate_->timings(this, timings_);
+    }
     delegate_->finish();
     return !hasError_;
 }
 
+void Compiler::enableTiming() {
+    timing_ = true;
+    startCountingAllocations();
+}
+
+void Compiler::addTiming(Timing timing) {
+    if (timing_) {
+        timings_.emplace_back(std::move(timing));
+    }
+}
+
 void Compiler::ParsePhase::perform(Compiler *compiler) {
     compiler->mainPackage_->parse(compiler->mainFile_);
 }
@@ -58,17 +100,36 @@ void Compiler::AnalysisPhase::perform(Compiler *compiler) {
 
 void Compiler::PrintInterfacePhase::perform(Compiler *compiler) {
     PrettyPrinter(compiler->mainPackage()).printInterface(path_);
+    writeTokenCache(path_);
 }
 
 void Compiler::GenerationPhase::perform(Compiler *compiler) {
     assert(compiler->generator_ == nullptr);
-    compiler->generator_ = std::make_unique<CodeGenerator>(compiler, optimize_);
+    compiler->generator_ = std::make_unique<CodeGenerator>(compiler, optimize_, linkTimeOptimize_, cpu_, features_);
     compiler->generator_->generate();
 }
 
 void Compiler::ObjectFileEmissionPhase::perform(Compiler *compiler) {
     assert(compiler->generator_ != nullptr && "ObjectFileEmissionPhase must be run after GenerationPhase");
-    compiler->generator_->emit(false, path_);
+    auto paths = compiler->generator_->emitObjectFiles(path_, jobs_);
+    if (paths.size() == 1) {
+        return;
+    }
+
+    std::vector<std::string> arguments { "-r", "-nostdlib", "-o", path_ };
+    arguments.insert(arguments.end(), paths.begin(), paths.end());
+    auto success = execute(linker_, arguments);
+    for (auto &path : paths) {
+        llvm::sys::fs::remove(path);
+    }
+    if (!success) {
+        throw CompilerError(SourcePosition(), "Could not combine the partial object files into ", path_, ".");
+    }
+}
+
+void Compiler::BitcodeEmissionPhase::perform(Compiler *compiler) {
+    assert(compiler->generator_ != nullptr && "BitcodeEmissionPhase must be run after GenerationPhase");
+    compiler->generator_->emitBitcode(path_);
 }
 
 void Compiler::LLVMIREmissionPhase::perform(Compiler *compiler) {
@@ -77,32 +138,49 @@ void Compiler::LLVMIREmissionPhase::perform(Compiler *compiler) {
 }
 
 void Compiler::LinkPhase::perform(Compiler *compiler) {
-    std::stringstream cmd;
-
-    cmd << linker_ << " " << objectFilePath_;
+    std::vector<std::string> arguments { objectFilePath_ };
 
     for (auto it = compiler->packageImportOrder_.rbegin(); it != compiler->packageImportOrder_.rend(); it++) {
         auto package = *it;
-        auto path = compiler->findBinaryPathPackage(package->path(), package->name());
-        cmd << " " << path;
+        arguments.emplace_back(compiler->findBinaryPathPackage(package->path(), package->name()));
         for (auto &hint : package->linkHints()) {
-            cmd << " -l" << hint;
+            arguments.emplace_back("-l" + hint);
         }
     }
 
-    auto runtimeLib = compiler->findBinaryPathPackage(compiler->searchPackage("runtime", SourcePosition()), "runtime");
-    cmd << " " << runtimeLib << " -o " << outPath_;
-
-    system(cmd.str().c_str());
+    arguments.emplace_back(compiler->findRuntimeLibrary());
+    // All code is compiled with function and data sections, so that unreferenced ones can be discarded.
+#ifdef __APPLE__
+    arguments.emplace_back("-Wl,-dead_strip");
+#else
+    arguments.emplace_back("-Wl,--gc-sections");
+#endif
+    arguments.insert(arguments.end(), arguments_.begin(), arguments_.end());
+    arguments.emplace_back("-o");
+    arguments.emplace_back(outPath_);
+
+    if (!execute(linker_, arguments)) {
+        throw CompilerError(SourcePosition(), "Linking ", outPath_, " with ", linker_, " failed.");
+    }
 }
 
 void Compiler::ArchivePhase::perform(Compiler *compiler) {
-    std::string cmd = ar_;
-    cmd.append(" cr ");
-    cmd.append(outPath_);
-    cmd.append(" ");
-    cmd.append(objectFilePath_);
-    system(cmd.c_str());
+    auto member = llvm::NewArchiveMember::getFile(objectFilePath_, true);
+    if (!member) {
+        throw CompilerError(SourcePosition(), "Could not read ", objectFilePath_, ": ",
+                            llvm::toString(member.takeError()));
+    }
+#ifdef __APPLE__
+    auto kind = llvm::object::Archive::K_DARWIN;
+#else
+    auto kind = llvm::object::Archive::K_GNU;
+#endif
+    std::vector<llvm::NewArchiveMember> members;
+    members.emplace_back(std::move(*member));
+    if (auto error = llvm::writeArchive(outPath_, members, true, kind, true, false)) {
+        throw CompilerError(SourcePosition(), "Could not write archive ", outPath_, ": ",
+                            llvm::toString(std::move(error)));
+    }
 }
 
 std::string Compiler::searchPackage(const std::string &name, const SourcePosition &p) {
@@ -127,6 +205,14 @@ std::string Compiler::findBinaryPathPackage(const std::string &packagePath, cons
     return packagePath + "/lib" + packageName + ".a";
 }
 
+std::string Compiler::findRuntimeLibrary() {
+    return findBinaryPathPackage(searchPackage("runtime", SourcePosition()), "runtime");
+}
+
+std::string Compiler::findBitcodePathPackage(const std::string &packagePath, const std::string &packageName) {
+    return packagePath + "/lib" + packageName + ".bc";
+}
+
 Package *Compiler::findPackage(const std::string &name) const {
     auto it = packages_.find(name);
     return it != packages_.end() ? it->second.get() : nullptr;
@@ -145,12 +231,18 @@ Package *Compiler::loadPackage(const std::string &name, const SourcePosition &p,
     auto rawPtr = package.get();
     packageImportOrder_.emplace_back(rawPtr);
     packages_.emplace(name, std::move(package));
+
+    // The timing includes the packages imported by this package that had not been loaded before.
+    Stopwatch stopwatch(timing_);
+    stopwatch.start();
     parseInterface(rawPtr, p);
 
     SemanticAnalyser(rawPtr, true).analyse(false);
     if (!hasError_) {
         MFAnalyser(rawPtr).analyse();
     }
+    stopwatch.stop();
+    addTiming(stopwatch.timing("package", name));
     return rawPtr;
 }
 
@@ -163,15 +255,52 @@ void Compiler::parseInterface(Package *pkg, const SourcePosition &p) {
     pkg->parse(textExists ? textPath : emojiPath);
 }
 
+/// The diagnostics collected by collectDiagnostics() on this thread or nullptr if diagnostics are issued immediately.
+static thread_local std::vector<Compiler::Diagnostic> *collectedDiagnostics = nullptr;
+
 void Compiler::error(const CompilerError &ce) {
     hasError_ = true;
+    if (collectedDiagnostics != nullptr) {
+        collectedDiagnostics->emplace_back(true, ce);
+        return;
+    }
     delegate_->error(this, ce);
 }
 
 void Compiler::warn(const SourcePosition &p, const std::string &warning) {
+    if (collectedDiagnostics != nullptr) {
+        collectedDiagnostics->emplace_back(false, CompilerError(p, warning));
+        return;
+    }
     delegate_->warn(this, warning, p);
 }
 
+std::vector<Compiler::Diagnostic> Compiler::collectDiagnostics(const std::function<void ()> &function) {
+    std::vector<Diagnostic> diagnostics;
+    auto previous = collectedDiagnostics;
+    collectedDiagnostics = &diagnostics;
+    try {
+        function();
+    }
+    catch (...) {
+        collectedDiagnostics = previous;
+        throw;
+    }
+    collectedDiagnostics = previous;
+    return diagnostics;
+}
+
+void Compiler::issueDiagnostics(const std::vector<Diagnostic> &diagnostics) {
+    for (auto &diagnostic : diagnostics) {
+        if (diagnostic.isError) {
+            delegate_->error(this, diagnostic.ce);
+        }
+        else {
+            delegate_->warn(this, diagnostic.ce.message(), diagnostic.ce.position());
+        }
+    }
+}
+
 Class *getStandardClass(const std::u32string &name, Package *_) {
     Type type = Type::noReturn();
     _->lookupRawType(TypeIdentifier(name, kDefaultNamespace, SourcePosition()), &type);
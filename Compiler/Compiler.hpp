@@ -11,6 +11,10 @@
 
 #include "Utils/StringUtils.hpp"
 #include "Lex/SourceManager.hpp"
+#include "Timing.hpp"
+#include "CompilerError.hpp"
+#include <atomic>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -44,6 +48,8 @@ public:
     /// @param p The location at which the warning was issued.
     /// @param message A string message describing the warning.
     virtual void warn(Compiler *compiler, const std::string &message, const SourcePosition &p) = 0;
+    /// Called just before finish() with all timings recorded if timing was enabled with Compiler::enableTiming().
+    virtual void timings(Compiler *compiler, const std::vector<Timing> &timings) = 0;
     /// Called when the compilation stops, i.e. just before Compiler::compile returns.
     virtual void finish() = 0;
 
@@ -61,12 +67,15 @@ public:
     class Phase {
     public:
         virtual void perform(Compiler *compiler) = 0;
+        /// @returns The name under which the time spent in this phase is reported.
+        virtual const char* name() const = 0;
         virtual ~Phase() = default;
     };
 
     /// Parses the main package.
     class ParsePhase final : public Phase {
         void perform(Compiler *compiler) override;
+        const char* name() const override { return "parse"; }
     };
 
     /// Analyses the main package. Must be preceded by ParsePhase.
@@ -75,16 +84,18 @@ public:
         /// @param standalone If the package is a standalone package a start flag block is required.
         AnalysisPhase(bool standalone) : standalone_(standalone) {}
         void perform(Compiler *compiler) override;
+        const char* name() const override { return "analysis"; }
     private:
         bool standalone_;
     };
 
-    /// Prints the interface. Must be preceded by AnalysisPhase.
+    /// Prints the interface and writes its token cache. Must be preceded by AnalysisPhase.
     class PrintInterfacePhase final : public Phase {
     public:
         /// @param path The path at which an interface file for the main package shall be created.
         PrintInterfacePhase(std::string path) : path_(std::move(path)) {}
         void perform(Compiler *compiler) override;
+        const char* name() const override { return "interface"; }
     private:
         std::string path_;
     };
@@ -93,17 +104,47 @@ public:
     class GenerationPhase final : public Phase {
     public:
         /// @param optimize Whether optimizations should be run.
-        GenerationPhase(bool optimize) : optimize_(optimize) {}
+        /// @param linkTimeOptimize Whether the bitcode of imported packages shall be linked into the generated module
+        ///                         before it is optimized. Only applicable to standalone executables.
+        /// @param cpu The name of the CPU for which code is generated.
+        /// @param features Target features that are enabled or disabled in addition to those of the CPU.
+        GenerationPhase(bool optimize, bool linkTimeOptimize = false, std::string cpu = "generic",
+                        std::string features = "")
+            : optimize_(optimize), linkTimeOptimize_(linkTimeOptimize), cpu_(std::move(cpu)),
+              features_(std::move(features)) {}
         void perform(Compiler *compiler) override;
+        const char* name() const override { return "generation"; }
     private:
         bool optimize_;
+        bool linkTimeOptimize_;
+        std::string cpu_;
+        std::string features_;
     };
 
     /// Emits the generated code to an object file. Must be preceded by GenerationPhase.
     class ObjectFileEmissionPhase final : public Phase {
     public:
-        ObjectFileEmissionPhase(std::string path) : path_(std::move(path)) {}
+        /// @param jobs The number of threads that emit machine code in parallel. If greater than 1, each thread
+        ///             emits a partial object file and these are combined into one with `linker`.
+        /// @param linker Name of or path to the linker used to combine the partial object files, optionally followed
+        ///               by arguments that are passed before all others.
+        ObjectFileEmissionPhase(std::string path, unsigned jobs = 1, std::string linker = "")
+            : path_(std::move(path)), jobs_(jobs), linker_(std::move(linker)) {}
         void perform(Compiler *compiler) override;
+        const char* name() const override { return "object file emission"; }
+    private:
+        std::string path_;
+        unsigned jobs_;
+        std::string linker_;
+    };
+
+    /// Emits the generated code as LLVM bitcode, which is used for link-time optimization. Must be preceded by
+    /// GenerationPhase and must precede ObjectFileEmissionPhase.
+    class BitcodeEmissionPhase final : public Phase {
+    public:
+        BitcodeEmissionPhase(std::string path) : path_(std::move(path)) {}
+        void perform(Compiler *compiler) override;
+        const char* name() const override { return "bitcode emission"; }
     private:
         std::string path_;
     };
@@ -113,37 +154,46 @@ public:
     public:
         LLVMIREmissionPhase(std::string path) : path_(std::move(path)) {}
         void perform(Compiler *compiler) override;
+        const char* name() const override { return "IR emission"; }
     private:
         std::string path_;
     };
 
-    /// Links an object file with the archives of the imported packages of the Compiler.
+    /// Links the object file of the main package with the archives of all imported packages and the runtime into an
+    /// executable by running a C++ compiler driver, which is passed the arguments directly without a shell.
     class LinkPhase final : public Phase {
     public:
         /// @param objectFilePath Where the object file of the main package is located.
         /// @param outPath Where the linked binary shall be placed.
-        /// @param linker Name of or path to the linker to use.
-        LinkPhase(std::string objectFilePath, std::string outPath, std::string linker)
-            : objectFilePath_(std::move(objectFilePath)), outPath_(std::move(outPath)), linker_(std::move(linker)) {}
+        /// @param linker Name of or path to the compiler driver to use, optionally followed by arguments that are
+        ///               passed before all others, e.g. `ccache c++`.
+        /// @param arguments Additional arguments for the compiler driver, e.g. `-fuse-ld=lld` or `-Wl,--icf=all`.
+        LinkPhase(std::string objectFilePath, std::string outPath, std::string linker,
+                  std::vector<std::string> arguments = {})
+            : objectFilePath_(std::move(objectFilePath)), outPath_(std::move(outPath)), linker_(std::move(linker)),
+              arguments_(std::move(arguments)) {}
         void perform(Compiler *compiler) override;
+        const char* name() const override { return "link"; }
     private:
         std::string objectFilePath_;
         std::string outPath_;
         std::string linker_;
+        std::vector<std::string> arguments_;
     };
 
+    /// Writes an archive containing the object file of the main package. The archive is written by the compiler
+    /// itself, any existing file at the path is replaced.
     class ArchivePhase final : public Phase {
     public:
         /// @param objectFilePath Where the object file of the main package is located.
         /// @param outPath Where the archive shall be placed.
-        /// @param ar Name of or path to the archiver to use.
-        ArchivePhase(std::string objectFilePath, std::string outPath, std::string ar)
-            : objectFilePath_(std::move(objectFilePath)), outPath_(std::move(outPath)), ar_(std::move(ar)) {}
+        ArchivePhase(std::string objectFilePath, std::string outPath)
+            : objectFilePath_(std::move(objectFilePath)), outPath_(std::move(outPath)) {}
         void perform(Compiler *compiler) override;
+        const char* name() const override { return "archive"; }
     private:
         std::string objectFilePath_;
         std::string outPath_;
-        std::string ar_;
     };
 
     /// Constructs an Compiler instance.
@@ -161,6 +211,18 @@ public:
     /// @return True iff the compilation completed without error.
     bool compile();
 
+    /// Sets the number of threads on which function bodies are analysed concurrently. The default is 1, i.e. bodies
+    /// are analysed sequentially.
+    void setAnalysisJobs(unsigned jobs) { analysisJobs_ = jobs; }
+    unsigned analysisJobs() const { return analysisJobs_; }
+
+    /// Enables recording the wall-clock time, CPU time, peak resident set size and allocations of each phase, each
+    /// imported package and the LLVM pass groups. The timings are passed to CompilerDelegate::timings().
+    void enableTiming();
+    bool timing() const { return timing_; }
+    /// Records a timing if timing is enabled.
+    void addTiming(Timing timing);
+
     RecordingPackage* mainPackage() const { return mainPackage_.get(); }
 
     std::vector<Package *> importedPackages() const { return packageImportOrder_; }
@@ -181,6 +243,21 @@ public:
     /// Issues a compiler error. The compilation can continue, but no code will be generated.
     void error(const CompilerError &ce);
 
+    /// An error or warning whose issuing was deferred by collectDiagnostics().
+    struct Diagnostic {
+        Diagnostic(bool isError, CompilerError ce) : isError(isError), ce(std::move(ce)) {}
+        bool isError;
+        /// For warnings only the message and position are relevant.
+        CompilerError ce;
+    };
+
+    /// Calls `function` and collects all errors and warnings issued on the calling thread meanwhile instead of
+    /// passing them to the delegate. This allows work on several threads to issue diagnostics in a deterministic
+    /// order with issueDiagnostics(). Errors are still recorded, i.e. compile() fails, immediately.
+    std::vector<Diagnostic> collectDiagnostics(const std::function<void ()> &function);
+    /// Passes diagnostics returned by collectDiagnostics() to the delegate.
+    void issueDiagnostics(const std::vector<Diagnostic> &diagnostics);
+
     /// Loads the package with the given name. If the package has already been loaded it is returned immediately.
     /// @param requestor The package that caused the call to this method.
     /// @see findPackage()
@@ -188,6 +265,14 @@ public:
 
     void assignSTypes(Package *s);
 
+    /// @returns The path at which the bitcode of the package is expected if it was compiled for link-time
+    /// optimization.
+    std::string findBitcodePathPackage(const std::string &packagePath, const std::string &packageName);
+    /// @returns The path at which the archive of the package is expected.
+    std::string findBinaryPathPackage(const std::string &packagePath, const std::string &packageName);
+    /// @returns The path of the archive of the run-time library, which is linked into every executable.
+    std::string findRuntimeLibrary();
+
     Class *sString = nullptr;
     Class *sError = nullptr;
     ValueType *sList = nullptr;
@@ -207,7 +292,6 @@ private:
     std::vector<std::unique_ptr<Phase>> phases_;
     std::string searchPackage(const std::string &name, const SourcePosition &p);
     void parseInterface(Package *pkg, const SourcePosition &p);
-    std::string findBinaryPathPackage(const std::string &packagePath, const std::string &packageName);
 
     /// Searches the loaded packages for the package with the given name.
     /// If the package has not been loaded yet @c nullptr is returned.
@@ -216,7 +300,10 @@ private:
     std::map<std::string, std::unique_ptr<Package>> packages_;
     std::vector<Package *> packageImportOrder_;
 
-    bool hasError_ = false;
+    std::atomic<bool> hasError_ { false };
+    unsigned analysisJobs_ = 1;
+    bool timing_ = false;
+    std::vector<Timing> timings_;
     std::string mainFile_;
     const std::vector<std::string> packageSearchPaths_;
     const std::unique_ptr<CompilerDelegate> delegate_;
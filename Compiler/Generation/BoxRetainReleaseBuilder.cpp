@@ -97,7 +97,18 @@ void buildDestructor(CodeGenerator *cg, TypeDefinition *typeDef) {
 }
 
 
+llvm::Constant* boxRetainReleaseConstant(CodeGenerator *cg, llvm::Function *function) {
+    if (function == nullptr) {
+        return llvm::ConstantPointerNull::get(cg->typeHelper().boxRetainRelease()->getPointerTo());
+    }
+    return function;
+}
+
 std::pair<llvm::Function*, llvm::Function*> buildBoxRetainRelease(CodeGenerator *cg, const Type &type) {
+    if (!type.isManaged()) {
+        return std::make_pair(nullptr, nullptr);
+    }
+
     auto release = createFunction(cg, mangleBoxRelease(type));
     auto retain = createFunction(cg, mangleBoxRetain(type));
 
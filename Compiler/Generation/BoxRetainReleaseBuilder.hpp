@@ -17,7 +17,13 @@ class Type;
 class ValueType;
 class TypeDefinition;
 
-std::pair<llvm::Function*, llvm::Function*> buildBoxRetainRelease(CodeGenerator *cg, const Type &type); 
+/// Builds the functions that retain and release a value of `type` stored in a box.
+/// @returns A pair of null pointers if `type` is not managed. Box infos and protocol conformances then contain null
+/// instead of a function that does nothing, which allows FunctionCodeGenerator::manageBox() to skip the indirect call
+/// for boxed primitives. Use boxRetainReleaseConstant() to store the functions.
+std::pair<llvm::Function*, llvm::Function*> buildBoxRetainRelease(CodeGenerator *cg, const Type &type);
+/// @returns `function` or a null pointer of the box retain/release function type if `function` is null.
+llvm::Constant* boxRetainReleaseConstant(CodeGenerator *cg, llvm::Function *function);
 void buildCopyRetain(CodeGenerator *cg, ValueType *typeDef);
 void buildDestructor(CodeGenerator *cg, TypeDefinition *typeDef);
 llvm::Function* createMemoryFunction(const std::string &str, CodeGenerator *cg, TypeDefinition *typeDef);
@@ -22,9 +22,15 @@
 #include "Creator.hpp"
 #include "RunTimeTypeInfoFlags.hpp"
 #include <algorithm>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/CodeGen/ParallelCG.h>
 #include <llvm/IR/IRPrintingPasses.h>
+#include <llvm/IR/InstIterator.h>
 #include <llvm/IR/Verifier.h>
+#include <llvm/Linker/Linker.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/TargetRegistry.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/raw_ostream.h>
@@ -33,39 +39,61 @@
 #include <llvm/Transforms/IPO.h>
 #include <llvm/Transforms/Scalar.h>
 #include <llvm/Transforms/Utils.h>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace EmojicodeCompiler {
 
-CodeGenerator::CodeGenerator(Compiler *compiler, bool optimize)
+CodeGenerator::CodeGenerator(Compiler *compiler, bool optimize, bool linkTimeOptimize, std::string cpu,
+                             std::string features)
 : compiler_(compiler), typeHelper_(context(), this),
   module_(std::make_unique<llvm::Module>(compiler->mainPackage()->name(), context())),
   pool_(std::make_unique<StringPool>(this)), runTime_(std::make_unique<RunTimeHelper>(this)),
-  optimizationManager_(std::make_unique<OptimizationManager>(module_.get(), optimize, runTime_.get())) {
+  functionPassesStopwatch_(compiler->timing()),
+  linkTimeOptimize_(linkTimeOptimize), targetTriple_(llvm::sys::getDefaultTargetTriple()), cpu_(std::move(cpu)),
+  features_(std::move(features)) {
     runTime_->declareRunTime();
+    initializeTargets();
 
-    llvm::InitializeAllTargetInfos();
-    llvm::InitializeAllTargets();
-    llvm::InitializeAllTargetMCs();
-    llvm::InitializeAllAsmParsers();
-    llvm::InitializeAllAsmPrinters();
+    targetMachine_ = createTargetMachine();
+    module()->setDataLayout(targetMachine_->createDataLayout());
+    module()->setTargetTriple(targetTriple_);
+    // The passes use the cost model of the target machine, which must therefore be created first.
+    optimizationManager_ = std::make_unique<OptimizationManager>(module_.get(), optimize, runTime_.get(),
+                                                                 targetMachine_.get());
+}
 
-    auto targetTriple = llvm::sys::getDefaultTargetTriple();
+CodeGenerator::~CodeGenerator() = default;
+
+void CodeGenerator::initializeTargets() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        llvm::InitializeAllTargetInfos();
+        llvm::InitializeAllTargets();
+        llvm::InitializeAllTargetMCs();
+        llvm::InitializeAllAsmParsers();
+        llvm::InitializeAllAsmPrinters();
+    });
+}
+
+std::unique_ptr<llvm::TargetMachine> CodeGenerator::createTargetMachine() const {
     std::string error;
-    auto target = llvm::TargetRegistry::lookupTarget(targetTriple, error);
+    auto target = llvm::TargetRegistry::lookupTarget(targetTriple_, error);
 
-    auto cpu = "generic";
-    auto features = "";
+    if (target == nullptr) {
+        throw CompilerError(SourcePosition(), "Cannot generate code for ", targetTriple_, ": ", error);
+    }
 
     llvm::TargetOptions opt;
-    targetMachine_ = target->createTargetMachine(targetTriple, cpu, features, opt, llvm::Reloc::PIC_);
-
-    module()->setDataLayout(targetMachine_->createDataLayout());
-    module()->setTargetTriple(targetTriple);
+    // Allows the linker to discard unreferenced functions and globals, see Compiler::LinkPhase.
+    opt.FunctionSections = true;
+    opt.DataSections = true;
+    return std::unique_ptr<llvm::TargetMachine>(target->createTargetMachine(targetTriple_, cpu_, features_, opt,
+                                                                            llvm::Reloc::PIC_));
 }
 
-CodeGenerator::~CodeGenerator() = default;
-
 Compiler* CodeGenerator::compiler() const {
     return compiler_;
 }
@@ -106,8 +134,43 @@ void CodeGenerator::generate() {
         generateFunctions(package, true);
     }
     generateFunctions(compiler()->mainPackage(), false);
+    generateReferencedLocalFunctions();
+
+    compiler()->addTiming(functionPassesStopwatch_.timing("passes", "function passes"));
 
+    if (linkTimeOptimize_) {
+        Stopwatch stopwatch(compiler()->timing());
+        stopwatch.start();
+        for (auto package : compiler()->importedPackages()) {
+            linkPackageBitcode(package);
+        }
+        stopwatch.stop();
+        compiler()->addTiming(stopwatch.timing("passes", "bitcode linking"));
+    }
+
+    Stopwatch stopwatch(compiler()->timing());
+    stopwatch.start();
     optimizationManager_->optimize(module());
+    stopwatch.stop();
+    compiler()->addTiming(stopwatch.timing("passes", "module passes"));
+}
+
+void CodeGenerator::linkPackageBitcode(Package *package) {
+    auto path = compiler()->findBitcodePathPackage(package->path(), package->name());
+    auto buffer = llvm::MemoryBuffer::getFile(path);
+    if (!buffer) {
+        return;
+    }
+    auto packageModule = llvm::parseBitcodeFile((*buffer)->getMemBufferRef(), context());
+    if (!packageModule) {
+        llvm::consumeError(packageModule.takeError());
+        compiler()->warn(SourcePosition(), "The bitcode of package ", package->name(), " at ", path,
+                         " is invalid and was ignored.");
+        return;
+    }
+    if (llvm::Linker::linkModules(*module(), std::move(*packageModule))) {
+        throw CompilerError(SourcePosition(), "Could not link the bitcode of package ", package->name(), ".");
+    }
 }
 
 void CodeGenerator::emit(bool ir, const std::string &outPath) {
@@ -128,8 +191,53 @@ void CodeGenerator::emit(bool ir, const std::string &outPath) {
             throw std::domain_error("TargetMachine can't emit a file of this type");
         }
     }
+    Stopwatch stopwatch(compiler()->timing());
+    stopwatch.start();
     pass.run(*module());
     dest.flush();
+    stopwatch.stop();
+    compiler()->addTiming(stopwatch.timing("passes", ir ? "IR printing" : "code generation"));
+}
+
+std::vector<std::string> CodeGenerator::emitObjectFiles(const std::string &outPath, unsigned jobs) {
+    if (jobs <= 1) {
+        emit(false, outPath);
+        return { outPath };
+    }
+
+    std::vector<std::string> paths;
+    std::vector<std::unique_ptr<llvm::raw_fd_ostream>> streams;
+    std::vector<llvm::raw_pwrite_stream *> streamPtrs;
+    for (unsigned i = 0; i < jobs; i++) {
+        paths.emplace_back(outPath + "." + std::to_string(i) + ".o");
+        std::error_code errorCode;
+        streams.emplace_back(std::make_unique<llvm::raw_fd_ostream>(paths.back(), errorCode,
+                                                                    llvm::sys::fs::F_None));
+        if (errorCode) {
+            throw CompilerError(SourcePosition(), "Could not open ", paths.back(), ": ", errorCode.message());
+        }
+        streamPtrs.emplace_back(streams.back().get());
+    }
+
+    Stopwatch stopwatch(compiler()->timing());
+    stopwatch.start();
+    // Locals are kept in the partition of their users instead of being externalized, so that the partial object
+    // files of different packages do not export clashing symbols and the linker can still discard unused functions.
+    llvm::splitCodeGen(std::move(module_), streamPtrs, {}, [this] { return createTargetMachine(); },
+                       llvm::TargetMachine::CGFT_ObjectFile, true);
+    for (auto &stream : streams) {
+        stream->flush();
+    }
+    stopwatch.stop();
+    compiler()->addTiming(stopwatch.timing("passes", "code generation"));
+    return paths;
+}
+
+void CodeGenerator::emitBitcode(const std::string &outPath) {
+    std::error_code errorCode;
+    llvm::raw_fd_ostream dest(outPath, errorCode, llvm::sys::fs::F_None);
+    llvm::WriteBitcodeToFile(*module(), dest);
+    dest.flush();
 }
 
 void CodeGenerator::generateFunctions(Package *package, bool imported) {
@@ -149,16 +257,102 @@ void CodeGenerator::generateFunctions(Package *package, bool imported) {
 }
 
 void CodeGenerator::generateFunction(Function *function) {
-    if (!function->isExternal()) {
-        function->eachReification([this, function](auto &reification) {
-            typeHelper_.withReificationContext(ReificationContext(*function, reification), [&] {
-                FunctionCodeGenerator(function, reification.entity.function, this).generate();
-            });
-            optimizationManager_->optimize(reification.entity.function);
+    if (function->isExternal()) {
+        return;
+    }
+    if (llvm::GlobalValue::isLocalLinkage(linkageForFunction(function))) {
+        localFunctions_.emplace_back(function);
+        return;
+    }
+    function->eachReification([this, function](auto &reification) {
+        generateReification(function, reification);
+    });
+}
+
+template <typename Reification>
+void CodeGenerator::generateReification(Function *function, Reification &reification) {
+    typeHelper_.withReificationContext(ReificationContext(*function, reification), [&] {
+        FunctionCodeGenerator(function, reification.entity.function, this).generate();
+    });
+    functionPassesStopwatch_.start();
+    optimizationManager_->optimize(reification.entity.function);
+    functionPassesStopwatch_.stop();
+}
+
+/// The reifications of local functions that have not been generated yet by their LLVM function.
+using PendingReifications = std::unordered_map<llvm::Function *, std::pair<Function *, Function::Reification *>>;
+
+/// Adds the pending functions that are operands of `user` to `worklist`. Constants and the initializers of globals
+/// are searched as well, since a function may also be referenced through a bitcast or a table. `visited` contains
+/// the constants that were already searched.
+static void findReferencedFunctions(llvm::User *user, const PendingReifications &pending,
+                                    std::unordered_set<llvm::Constant *> &visited,
+                                    std::vector<llvm::Function *> &worklist) {
+    for (auto &operand : user->operands()) {
+        if (auto function = llvm::dyn_cast<llvm::Function>(operand)) {
+            if (pending.count(function) > 0) {
+                worklist.emplace_back(function);
+            }
+        }
+        else if (auto global = llvm::dyn_cast<llvm::GlobalVariable>(operand)) {
+            if (global->hasInitializer() && visited.insert(global).second) {
+                findReferencedFunctions(global->getInitializer(), pending, visited, worklist);
+            }
+        }
+        else if (auto constant = llvm::dyn_cast<llvm::Constant>(operand)) {
+            if (visited.insert(constant).second) {
+                findReferencedFunctions(constant, pending, visited, worklist);
+            }
+        }
+    }
+}
+
+void CodeGenerator::generateReferencedLocalFunctions() {
+    PendingReifications pending;
+    std::vector<llvm::Function *> worklist;
+    for (auto function : localFunctions_) {
+        function->eachReification([&](auto &reification) {
+            auto fn = reification.entity.function;
+            pending.emplace(fn, std::make_pair(function, &reification));
+            if (!fn->use_empty()) {
+                worklist.emplace_back(fn);
+            }
+        });
+    }
+
+    // Only the code of a newly generated reification can reference further local functions, so just its
+    // instructions are searched instead of checking the uses of all pending reifications again.
+    std::unordered_set<llvm::Constant *> visited;
+    while (!worklist.empty()) {
+        auto it = pending.find(worklist.back());
+        worklist.pop_back();
+        if (it == pending.end()) {
+            continue;
+        }
+        auto fn = it->first;
+        auto reification = it->second;
+        pending.erase(it);
+        generateReification(reification.first, *reification.second);
+        for (auto &inst : llvm::instructions(fn)) {
+            findReferencedFunctions(&inst, pending, visited, worklist);
+        }
+    }
+
+    for (auto function : localFunctions_) {
+        function->eachReification([](auto &reification) {
+            if (reification.entity.function->isDeclaration()) {
+                reification.entity.function->eraseFromParent();
+                reification.entity.function = nullptr;
+            }
         });
     }
 }
 
+bool CodeGenerator::generatesExecutable() const {
+    auto package = compiler()->mainPackage();
+    return package->hasStartFlagFunction() && !package->startFlagFunction()->isExternal();
+}
+
 llvm::Function* CodeGenerator::createLlvmFunction(Function *function, ReificationContext reificationContext) {
     llvm::FunctionType *ft;
     typeHelper().withReificationContext(reificationContext, [&] {
@@ -169,6 +363,12 @@ llvm::Function* CodeGenerator::createLlvmFunction(Function *function, Reificatio
 
     auto fn = llvm::Function::Create(ft, linkageForFunction(function), name, module());
     fn->addFnAttr(llvm::Attribute::NoUnwind);
+    // The vectorizers and the inliner query the subtarget of each function. Recording the target in the function
+    // keeps it intact when the function is linked into another module for link-time optimization.
+    fn->addFnAttr("target-cpu", cpu_);
+    if (!features_.empty()) {
+        fn->addFnAttr("target-features", features_);
+    }
     if (function->isInline()) {
         fn->addFnAttr(llvm::Attribute::InlineHint);
     }
@@ -270,6 +470,11 @@ llvm::Function::LinkageTypes CodeGenerator::linkageForFunction(Function *functio
          (function->owner() == nullptr || !function->owner()->exported())) || function->isClosure()) {
         return llvm::Function::PrivateLinkage;
     }
+    // Nothing outside an executable refers to its functions but the run-time library, which only calls 🏁.
+    if (generatesExecutable() && function->package() == compiler()->mainPackage() && !function->isExternal() &&
+        function != compiler()->mainPackage()->startFlagFunction()) {
+        return llvm::Function::InternalLinkage;
+    }
     return llvm::Function::ExternalLinkage;
 }
 
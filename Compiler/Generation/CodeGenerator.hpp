@@ -10,12 +10,14 @@
 #define CodeGenerator_hpp
 
 #include "LLVMTypeHelper.hpp"
+#include "Timing.hpp"
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/Module.h>
 #include <memory>
 #include <string>
 #include <map>
+#include <vector>
 
 namespace llvm {
 class TargetMachine;
@@ -41,7 +43,16 @@ class CodeGenerator {
 public:
     /// Creates a CodeGenerator bound to the provided Compiler.
     /// @param optimize Whether optimizations should be run.
-    CodeGenerator(Compiler *compiler, bool optimize);
+    /// @param linkTimeOptimize Whether the bitcode of imported packages shall be linked into the module before the
+    ///                         module is optimized. See linkPackageBitcode().
+    /// @param cpu The name of the CPU for which code is generated.
+    /// @param features Target features that are enabled or disabled in addition to those of the CPU.
+    CodeGenerator(Compiler *compiler, bool optimize, bool linkTimeOptimize = false, std::string cpu = "generic",
+                  std::string features = "");
+
+    /// Registers all LLVM targets. This is done by the constructor as well, but can be done ahead of time, e.g. by a
+    /// compile server. Thread-safe.
+    static void initializeTargets();
 
     /// Generates the package.
     void generate();
@@ -51,6 +62,18 @@ public:
     /// @pre Call generate().
     void emit(bool ir, const std::string &outPath);
 
+    /// Emits the generated code to object files. The module is split into `jobs` partitions, each of which is
+    /// cloned into its own LLVMContext and compiled to machine code on its own thread.
+    /// @returns The paths of the emitted object files. If `jobs` is 1 this is just `outPath`, otherwise the caller
+    ///          is responsible for combining the partial object files.
+    /// @pre Call generate().
+    /// @post The module was consumed and module() must not be used anymore if `jobs` is greater than 1.
+    std::vector<std::string> emitObjectFiles(const std::string &outPath, unsigned jobs);
+
+    /// Writes the module as LLVM bitcode to `outPath`.
+    /// @pre Call generate().
+    void emitBitcode(const std::string &outPath);
+
     /// The LLVM module that represents the package.
     llvm::Module* module() const { return module_.get(); }
 
@@ -84,11 +107,40 @@ private:
     std::unique_ptr<StringPool> pool_;
     std::unique_ptr<RunTimeHelper> runTime_;
     std::unique_ptr<OptimizationManager> optimizationManager_;
+    /// Measures the function passes, which run interleaved with the generation of the functions.
+    Stopwatch functionPassesStopwatch_;
+
+    std::unique_ptr<llvm::TargetMachine> targetMachine_;
+    bool linkTimeOptimize_;
+    std::string targetTriple_;
+    std::string cpu_;
+    std::string features_;
+
+    /// Creates a TargetMachine for the target of the module. Each thread that emits code requires its own one, which
+    /// is why this method must not access the module.
+    std::unique_ptr<llvm::TargetMachine> createTargetMachine() const;
+
+    /// Links the bitcode of the imported package into the module so that its functions become available for
+    /// inlining and interprocedural optimization. Packages that were not compiled with bitcode are skipped and
+    /// their archive is linked as usual.
+    void linkPackageBitcode(Package *package);
 
-    llvm::TargetMachine *targetMachine_ = nullptr;
+    /// The functions with local linkage whose reifications generateFunction() left to
+    /// generateReferencedLocalFunctions().
+    std::vector<Function *> localFunctions_;
 
     void generateFunctions(Package *package, bool imported);
+    /// Generates the reifications of the function unless it has local linkage, in which case it is added to
+    /// localFunctions_.
     void generateFunction(Function *function);
+    /// Generates the reifications of localFunctions_ that are referenced by generated code, a virtual table, a
+    /// protocol table or another global until no further reification becomes referenced. The declarations of all
+    /// other reifications are removed from the module, as nothing can call them.
+    void generateReferencedLocalFunctions();
+    template <typename Reification>
+    void generateReification(Function *function, Reification &reification);
+    /// Whether the main package is an executable, i.e. its 🏁 is included in the object file.
+    bool generatesExecutable() const;
 
     void addParamAttrs(const Parameter &param, size_t index, llvm::Function *function);
     void addParamDereferenceable(const Type &type, size_t index, llvm::Function *function, bool ret);
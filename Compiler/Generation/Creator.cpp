@@ -144,7 +144,8 @@ void PackageCreator::createBoxInfo(ValueType *valueType) {
     valueType->boxInfo()->setInitializer(llvm::ConstantStruct::get(generator_->typeHelper().boxInfo(), {
         generator_->runTime().createRtti(valueType, generator_->typeHelper().isRemote(Type(valueType)) ?
                                             RunTimeTypeInfoFlags::ValueTypeRemote : RunTimeTypeInfoFlags::ValueType),
-        valueType->boxRetainRelease().first, valueType->boxRetainRelease().second,
+        boxRetainReleaseConstant(generator_, valueType->boxRetainRelease().first),
+        boxRetainReleaseConstant(generator_, valueType->boxRetainRelease().second),
         ProtocolsTableGenerator(generator_).createProtocolTable(valueType)
     }));
 }
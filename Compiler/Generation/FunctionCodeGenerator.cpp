@@ -472,10 +472,16 @@ void FunctionCodeGenerator::manageBox(bool retain, llvm::Value *boxInfo, llvm::V
     else {
         fnPtr = builder().CreateConstInBoundsGEP2_32(typeHelper().boxInfo(), boxInfo, 0, retain ? 1 : 2);
     }
-    auto call = builder().CreateCall(builder().CreateLoad(fnPtr, retain ? "retain" : "release"), value);
-    call->addParamAttr(0, llvm::Attribute::NoCapture);
-    call->addParamAttr(0, llvm::Attribute::ReadOnly);
-    call->addAttribute(llvm::AttributeList::FunctionIndex, llvm::Attribute::NoUnwind);
+    auto fn = builder().CreateLoad(fnPtr, retain ? "retain" : "release");
+    // Values that are not managed, like integers, have no retain and release functions. Checking for them avoids an
+    // indirect call for the most common contents of generic containers.
+    auto null = llvm::ConstantPointerNull::get(typeHelper().boxRetainRelease()->getPointerTo());
+    createIf(builder().CreateICmpNE(fn, null), [&] {
+        auto call = builder().CreateCall(fn, value);
+        call->addParamAttr(0, llvm::Attribute::NoCapture);
+        call->addParamAttr(0, llvm::Attribute::ReadOnly);
+        call->addAttribute(llvm::AttributeList::FunctionIndex, llvm::Attribute::NoUnwind);
+    });
 }
 
 bool FunctionCodeGenerator::isManagedByReference(const Type &type) const {
@@ -4,26 +4,35 @@
 
 #include "OptimizationManager.hpp"
 #include "ReferenceCountingPasses.hpp"
+#include <llvm/Analysis/TargetTransformInfo.h>
+#include <llvm/Target/TargetMachine.h>
 #include <llvm/Transforms/IPO.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
+#include <llvm/Transforms/InstCombine/InstCombine.h>
 #include <llvm/Transforms/Scalar.h>
 #include <llvm/Transforms/Scalar/GVN.h>
 
 namespace EmojicodeCompiler {
 
-OptimizationManager::OptimizationManager(llvm::Module *module, bool optimize, RunTimeHelper *runTime)
+OptimizationManager::OptimizationManager(llvm::Module *module, bool optimize, RunTimeHelper *runTime,
+                                         llvm::TargetMachine *targetMachine)
         : optimize_(optimize), functionPassManager_(std::make_unique<llvm::legacy::FunctionPassManager>(module)),
             passManager_(std::make_unique<llvm::legacy::PassManager>()) {
-                initialize(runTime);
+                initialize(runTime, targetMachine);
             }
 
-void OptimizationManager::initialize(RunTimeHelper *runTime) {
+void OptimizationManager::initialize(RunTimeHelper *runTime, llvm::TargetMachine *targetMachine) {
     if (optimize_) {
         llvm::PassManagerBuilder builder;
         builder.OptLevel = 3;
         builder.SizeLevel = 0;
         builder.Inliner = llvm::createFunctionInliningPass();
         builder.MergeFunctions = true;
+        targetMachine->adjustPassManager(builder);
+
+        // Without the target's TargetTransformInfo the vectorizers and the inliner fall back to a generic cost model.
+        functionPassManager_->add(llvm::createTargetTransformInfoWrapperPass(targetMachine->getTargetIRAnalysis()));
+        passManager_->add(llvm::createTargetTransformInfoWrapperPass(targetMachine->getTargetIRAnalysis()));
 
         passManager_->add(new LocalReferenceCountingPass(runTime));
 
@@ -36,6 +45,12 @@ void OptimizationManager::initialize(RunTimeHelper *runTime) {
 
         passManager_->add(new ConstantReferenceCountingPass(runTime));
         passManager_->add(new RedundantReferenceCountingPass(runTime));
+        passManager_->add(new InlineReferenceCountingPass(runTime));
+        // Clean up the fast paths and let GVN and LICM move code around them.
+        passManager_->add(llvm::createInstructionCombiningPass());
+        passManager_->add(llvm::createCFGSimplificationPass());
+        passManager_->add(llvm::createGVNPass());
+        passManager_->add(llvm::createLICMPass());
     }
 }
 
@@ -10,6 +10,7 @@
 
 namespace llvm {
 class Function;
+class TargetMachine;
 }  // namespace llvm
 
 namespace EmojicodeCompiler {
@@ -18,10 +19,12 @@ class RunTimeHelper;
 
 class OptimizationManager {
 public:
-    explicit OptimizationManager(llvm::Module *module, bool optimize, RunTimeHelper *runTime);
+    /// @param targetMachine The target machine whose cost model and passes are used for optimization.
+    OptimizationManager(llvm::Module *module, bool optimize, RunTimeHelper *runTime,
+                        llvm::TargetMachine *targetMachine);
     void optimize(llvm::Function *function);
     void optimize(llvm::Module *module);
-    void initialize(RunTimeHelper *runTime);
+    void initialize(RunTimeHelper *runTime, llvm::TargetMachine *targetMachine);
 private:
     bool optimize_;
     std::unique_ptr<llvm::legacy::FunctionPassManager> functionPassManager_;
@@ -3,6 +3,7 @@
 //
 
 #include "ProtocolsTableGenerator.hpp"
+#include "BoxRetainReleaseBuilder.hpp"
 #include "CodeGenerator.hpp"
 #include "Functions/Function.hpp"
 #include "Generation/RunTimeHelper.hpp"
@@ -109,7 +110,9 @@ llvm::GlobalVariable* ProtocolsTableGenerator::createDispatchTable(const Type &t
                                        (type.type() == TypeType::Class ||
                                         generator_->typeHelper().isRemote(type)) ? 1 : 0);
     auto conformanceStruct = llvm::ConstantStruct::get(generator_->typeHelper().protocolConformance(),
-                                                 {load, avGep, llvm::ConstantExpr::getBitCast(boxInfo, generator_->typeHelper().boxInfo()->getPointerTo()), type.typeDefinition()->boxRetainRelease().first, type.typeDefinition()->boxRetainRelease().second });
+                                                 {load, avGep, llvm::ConstantExpr::getBitCast(boxInfo, generator_->typeHelper().boxInfo()->getPointerTo()),
+                                                 boxRetainReleaseConstant(generator_, type.typeDefinition()->boxRetainRelease().first),
+                                                 boxRetainReleaseConstant(generator_, type.typeDefinition()->boxRetainRelease().second) });
     return getConformanceVariable(type, conformance.type->type(), conformanceStruct);
 }
 
@@ -6,12 +6,15 @@
 //
 
 #include "ReferenceCountingPasses.hpp"
+#include <llvm/IR/MDBuilder.h>
+#include <llvm/Transforms/Utils/BasicBlockUtils.h>
 
 namespace EmojicodeCompiler {
 
 char ConstantReferenceCountingPass::id = 0;
 char LocalReferenceCountingPass::id = 0;
 char RedundantReferenceCountingPass::id = 0;
+char InlineReferenceCountingPass::id = 0;
 
 bool ReferenceCountingPass::runOnFunction(llvm::Function &function) {
     modified_ = false;
@@ -24,6 +27,7 @@ bool ReferenceCountingPass::runOnFunction(llvm::Function &function) {
             }
         }
     }
+    deleteInstructions();
     return modified_;
 }
 
@@ -84,13 +88,22 @@ void LocalReferenceCountingPass::transformMemoryInst(llvm::CallInst *callInst) {
 }
 
 void ConstantReferenceCountingPass::transformMemoryInst(llvm::CallInst *callInst)  {
-    auto operand = callInst->getArgOperand(0);
-    if (llvm::dyn_cast<llvm::ConstantExpr>(operand) != nullptr) {
+    if (isImmortalConstant(callInst->getArgOperand(0))) {
         toBeDeleted_.emplace_back(callInst);
         modified_ = true;
     }
 }
 
+bool ConstantReferenceCountingPass::isImmortalConstant(llvm::Value *value) const {
+    // Other globals, e.g. from linked bitcode, may be reference counted like any other object.
+    auto global = llvm::dyn_cast<llvm::GlobalVariable>(value->stripPointerCasts());
+    if (global == nullptr || !global->hasDefinitiveInitializer()) {
+        return false;
+    }
+    auto controlBlock = global->getInitializer()->getAggregateElement(0u);
+    return controlBlock != nullptr && controlBlock->stripPointerCasts() == runTime_->ignoreBlockPtr();
+}
+
 void RedundantReferenceCountingPass::transformBlock(llvm::BasicBlock &block) {
     std::map<llvm::Value*, std::vector<llvm::CallInst*>> retains;
     for (auto &inst : block) {
@@ -125,4 +138,83 @@ bool RedundantReferenceCountingPass::runOnFunction(llvm::Function &function) {
     return modified_;
 }
 
+bool InlineReferenceCountingPass::runOnFunction(llvm::Function &function) {
+    modified_ = false;
+    if (function.hasFnAttribute(kLoweredAttribute)) {
+        return false;
+    }
+    std::vector<llvm::CallInst*> calls;
+    for (auto &block : function) {
+        for (auto &inst : block) {
+            if (auto callInst = llvm::dyn_cast<llvm::CallInst>(&inst)) {
+                if (isMemoryFunction(callInst->getCalledFunction())) {
+                    calls.emplace_back(callInst);
+                }
+            }
+        }
+    }
+    if (calls.empty()) {
+        return false;
+    }
+    // The calls for objects on the stack remain and must not be lowered again.
+    function.addFnAttr(kLoweredAttribute);
+    // Transforming splits blocks, which is why the calls must be collected first.
+    for (auto callInst : calls) {
+        transformMemoryInst(callInst);
+    }
+    deleteInstructions();
+    modified_ = true;
+    return modified_;
+}
+
+void InlineReferenceCountingPass::transformMemoryInst(llvm::CallInst *callInst) {
+    auto &ctx = callInst->getContext();
+    auto unlikely = llvm::MDBuilder(ctx).createBranchWeights(1, 2000);
+    auto function = callInst->getCalledFunction();
+    auto object = callInst->getArgOperand(0);
+
+    llvm::IRBuilder<> builder(callInst);
+    // The control block is always the first field. The strong count is the first field of the control block.
+    auto countPtrType = llvm::Type::getInt32PtrTy(ctx);
+    auto controlBlock = builder.CreateLoad(builder.CreateBitCast(object, countPtrType->getPointerTo()));
+
+    llvm::Instruction *heap = callInst;
+    if (function == runTime_->retain() || function == runTime_->release()) {
+        // Objects allocated on the stack have no control block and are still handled by the run-time library.
+        llvm::Instruction *local;
+        llvm::SplitBlockAndInsertIfThenElse(builder.CreateIsNull(controlBlock), callInst, &local, &heap, unlikely);
+        callInst->moveBefore(local);
+    }
+    else {
+        toBeDeleted_.emplace_back(callInst);
+    }
+
+    auto counted = insertIfCounted(controlBlock, heap);
+    builder.SetInsertPoint(counted);
+    if (isRetainFunction(function)) {
+        builder.CreateAtomicRMW(llvm::AtomicRMWInst::Add, controlBlock, builder.getInt32(1),
+                                llvm::AtomicOrdering::Monotonic);
+    }
+    else {
+        auto count = builder.CreateAtomicRMW(llvm::AtomicRMWInst::Sub, controlBlock, builder.getInt32(1),
+                                             llvm::AtomicOrdering::AcquireRelease);
+        auto deallocate = llvm::SplitBlockAndInsertIfThen(builder.CreateICmpEQ(count, builder.getInt32(1)), counted,
+                                                          false, unlikely);
+        builder.SetInsertPoint(deallocate);
+        builder.CreateCall(function == runTime_->release() ? runTime_->deallocate() : runTime_->deallocateMemory(),
+                           object);
+    }
+    modified_ = true;
+}
+
+llvm::Instruction* InlineReferenceCountingPass::insertIfCounted(llvm::Value *controlBlock, llvm::Instruction *before) {
+    llvm::IRBuilder<> builder(before);
+    // Immortal objects have a negative strong count. Checking the sign of the count instead of comparing against
+    // ejcIgnoreBlock also covers objects that were made immortal at run-time and the branch is biased per call site.
+    auto count = builder.CreateAlignedLoad(controlBlock, 4);
+    count->setAtomic(llvm::AtomicOrdering::Monotonic);
+    auto likely = llvm::MDBuilder(builder.getContext()).createBranchWeights(2000, 1);
+    return llvm::SplitBlockAndInsertIfThen(builder.CreateICmpSGE(count, builder.getInt32(0)), before, false, likely);
+}
+
 }
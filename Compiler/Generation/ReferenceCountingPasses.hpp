@@ -35,7 +35,9 @@ protected:
     bool isReleaseFunction(llvm::Function *function);
 };
 
-/// Detects calls to the ejcRetain/Relase family with constant expresssions as argument and removes them.
+/// Detects calls to the ejcRetain/Relase family with constants, e.g. string literals, as argument and removes them.
+/// Constants emitted with the immortal control block, see RunTimeHelper::ignoreBlockPtr(), are not reference counted,
+/// so these calls have no effect.
 class ConstantReferenceCountingPass : public ReferenceCountingPass {
 public:
     static char id;
@@ -43,6 +45,8 @@ public:
     ConstantReferenceCountingPass(RunTimeHelper *runTime) : ReferenceCountingPass(runTime, id) {}
 private:
     void transformMemoryInst(llvm::CallInst *callInst) override;
+    /// @returns True if `value` is a global whose initializer begins with the immortal control block.
+    bool isImmortalConstant(llvm::Value *value) const;
 };
 
 /// This pass finds calls to the ejcRetain/Relase family where the argument is certainly stack allocated and replaces
@@ -77,6 +81,30 @@ private:
     bool runOnFunction(llvm::Function &function) override;
 };
 
+/// This pass replaces calls to ejcRetain, ejcRelease, ejcRetainMemory and ejcReleaseMemory with inline code that
+/// directly increments or decrements the strong count in the control block. Only objects allocated on the stack are
+/// still passed to the run-time library and only objects whose count drops to zero are passed to ejcDeallocate or
+/// ejcDeallocateMemory.
+///
+/// This pass must run after all other reference counting passes as these can only recognize the calls.
+///
+/// Transformed functions are marked with an attribute and skipped when they are encountered again, e.g. because
+/// they were linked in from the bitcode of a package for link-time optimization.
+class InlineReferenceCountingPass : public ReferenceCountingPass {
+public:
+    static char id;
+    static constexpr const char *kLoweredAttribute = "ejc-inline-reference-counting";
+
+    InlineReferenceCountingPass(RunTimeHelper *runTime) : ReferenceCountingPass(runTime, id) {}
+private:
+    bool runOnFunction(llvm::Function &function) override;
+    void transformMemoryInst(llvm::CallInst *callInst) override;
+
+    /// Splits the block before `before` and only executes the code inserted before the returned instruction if
+    /// `controlBlock` does not belong to an immortal object, i.e. its strong count is not negative.
+    llvm::Instruction* insertIfCounted(llvm::Value *controlBlock, llvm::Instruction *before);
+};
+
 }
 
 #endif /* ReferenceCountingPasses_hpp */
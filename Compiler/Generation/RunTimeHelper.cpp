@@ -91,6 +91,13 @@ void RunTimeHelper::declareRunTime() {
     releaseCapture_ = declareMemoryRunTimeFunction("ejcReleaseCapture");
     releaseLocal_ = declareMemoryRunTimeFunction("ejcReleaseLocal");
 
+    // Only called by the inlined fast paths of ejcRelease and ejcReleaseMemory once the count dropped to zero.
+    deallocate_ = declareMemoryRunTimeFunction("ejcDeallocate");
+    deallocate_->removeFnAttr(llvm::Attribute::NoRecurse);
+    deallocate_->addFnAttr(llvm::Attribute::Cold);
+    deallocateMemory_ = declareMemoryRunTimeFunction("ejcDeallocateMemory");
+    deallocateMemory_->addFnAttr(llvm::Attribute::Cold);
+
     isOnlyReference_ = declareRunTimeFunction("ejcIsOnlyReference", llvm::Type::getInt1Ty(generator_->context()),
                                      llvm::Type::getInt8PtrTy(generator_->context()));
     isOnlyReference_->addParamAttr(0, llvm::Attribute::NonNull);
@@ -56,6 +56,12 @@ public:
     /// (ejcReleaseCapture)
     /// @see release
     llvm::Function* releaseCapture() const { return releaseCapture_; }
+    /// Deinitializes and frees an object whose reference count has already been decremented to zero. (ejcDeallocate)
+    /// @note This function is only called from inlined fast paths of release(). See InlineReferenceCountingPass.
+    llvm::Function* deallocate() const { return deallocate_; }
+    /// Frees a memory area whose reference count has already been decremented to zero. (ejcDeallocateMemory)
+    /// @see deallocate
+    llvm::Function* deallocateMemory() const { return deallocateMemory_; }
     /// Used to find a protocol conformance in an array of ProtocolConformanceEntries. (ejcFindProtocolConformance)
     llvm::Function* findProtocolConformance() const { return findProtocolConformance_; }
 
@@ -68,6 +74,8 @@ public:
 
     llvm::Function* isOnlyReference() const { return isOnlyReference_; }
 
+    /// The immortal control block that all objects emitted as constants must use. Its strong count is negative,
+    /// which exempts the objects from reference counting.
     llvm::GlobalVariable* ignoreBlockPtr() const { return ignoreBlock_; }
 
     /// Declares the box info with the provided name. This is a global variable without initializer.
@@ -106,6 +114,8 @@ private:
     llvm::Function *releaseCapture_ = nullptr;
     llvm::Function *releaseWithoutDeinit_ = nullptr;
     llvm::Function *releaseLocal_ = nullptr;
+    llvm::Function *deallocate_ = nullptr;
+    llvm::Function *deallocateMemory_ = nullptr;
     llvm::Function *isOnlyReference_ = nullptr;
 
     llvm::Function *malloc_ = nullptr;
@@ -17,7 +17,7 @@
 
 namespace EmojicodeCompiler {
 
-llvm::Value* StringPool::pool(const std::u32string &string) {
+llvm::Constant* StringPool::pool(const std::u32string &string) {
     auto it = pool_.find(string);
     if (it != pool_.end()) {
         return it->second;
@@ -27,7 +27,7 @@ llvm::Value* StringPool::pool(const std::u32string &string) {
     return stringVar;
 }
 
-llvm::Value* StringPool::addToPool(const std::string &string) {
+llvm::Constant* StringPool::addToPool(const std::string &string) {
     auto data = llvm::ArrayRef<uint8_t>(reinterpret_cast<const uint8_t*>(string.data()), string.size());
     auto constant = llvm::ConstantStruct::getAnon({
         codeGenerator_->runTime().ignoreBlockPtr(),
@@ -48,10 +48,12 @@ llvm::Value* StringPool::addToPool(const std::string &string) {
         codeGenerator_->runTime().ignoreBlockPtr(),
         compiler->sString->classInfo(),
         varCast,
-        llvm::ConstantInt::get(llvm::Type::getInt64Ty(codeGenerator_->context()), string.size())
+        llvm::ConstantInt::get(llvm::Type::getInt64Ty(codeGenerator_->context()), string.size()),
+        llvm::Constant::getNullValue(stringLlvm->getElementType(4))
     });
 
-    auto stringVar = new llvm::GlobalVariable(*codeGenerator_->module(), stringLlvm, true,
+    // Not constant, because the grapheme index of the string is stored into it when it is first needed.
+    auto stringVar = new llvm::GlobalVariable(*codeGenerator_->module(), stringLlvm, false,
                                               llvm::GlobalValue::LinkageTypes::PrivateLinkage, stringStruct, "string");
     return stringVar;
 }
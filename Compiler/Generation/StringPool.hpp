@@ -13,7 +13,7 @@
 #include <string>
 
 namespace llvm {
-class Value;
+class Constant;
 }  // namespace llvm
 
 namespace EmojicodeCompiler {
@@ -28,10 +28,10 @@ public:
     /// Pools the given string. The pool is searched for an identical strings first, if no such string is found,
     /// the string is added to the end of the pool.
     /// @returns The index to access the string in the pool.
-    llvm::Value* pool(const std::u32string &string);
-    llvm::Value* addToPool(const std::string &string);
+    llvm::Constant* pool(const std::u32string &string);
+    llvm::Constant* addToPool(const std::string &string);
 private:
-    std::map<std::u32string, llvm::Value*> pool_;
+    std::map<std::u32string, llvm::Constant*> pool_;
     CodeGenerator *codeGenerator_;
 };
 
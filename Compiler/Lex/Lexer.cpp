@@ -13,59 +13,123 @@
 
 namespace EmojicodeCompiler {
 
+const std::array<uint8_t, 128> Lexer::kAsciiClasses = [] {
+    std::array<uint8_t, 128> classes{};
+    for (char c = 0x9; c <= 0xD; c++) {
+        classes[c] |= kAsciiWhitespace;
+    }
+    classes[' '] |= kAsciiWhitespace;
+    classes['\n'] |= kAsciiNewline;
+    for (char c = '0'; c <= '9'; c++) {
+        classes[c] |= kAsciiDigit;
+    }
+    return classes;
+}();
+
+const std::unordered_map<char32_t, TokenType>& Lexer::singleTokens() {
+    static const std::unordered_map<char32_t, TokenType> singleTokens = {
+        { E_HEAVY_PLUS_SIGN, TokenType::Operator },
+        { E_HEAVY_MINUS_SIGN, TokenType::Operator },
+        { E_HEAVY_DIVISION_SIGN, TokenType::Operator },
+        { E_HEAVY_MULTIPLICATION_SIGN, TokenType::Operator },
+        { E_OPEN_HANDS, TokenType::Operator },
+        { E_HANDSHAKE, TokenType::Operator },
+        { E_HEAVY_LARGE_CIRCLE, TokenType::Operator },
+        { E_ANGER_SYMBOL, TokenType::Operator },
+        { E_CROSS_MARK, TokenType::Operator },
+        { E_LEFT_POINTING_BACKHAND_INDEX, TokenType::Operator },
+        { E_RIGHT_POINTING_BACKHAND_INDEX, TokenType::Operator },
+        { E_PUT_LITTER_IN_ITS_SPACE, TokenType::Operator },
+        { E_HANDS_RAISED_IN_CELEBRATION, TokenType::Operator },
+        { E_FACE_WITH_STUCK_OUT_TONGUE_AND_WINKING_EYE, TokenType::Operator },
+        { E_RED_EXCLAMATION_MARK_AND_QUESTION_MARK, TokenType::Call },
+
+        { E_RED_EXCLAMATION_MARK, TokenType::EndArgumentList },
+        { E_RED_QUESTION_MARK, TokenType::EndInterrogativeArgumentList },
+        { E_RIGHT_FACING_FIST, TokenType::GroupBegin },
+        { E_LEFT_FACING_FIST, TokenType::GroupEnd },
+        { E_RIGHT_ARROW_CURVING_LEFT, TokenType::Return },
+        { E_CLOCKWISE_RIGHTWARDS_AND_LEFTWARDS_OPEN_CIRCLE_ARROWS, TokenType::RepeatWhile },
+        { E_CLOCKWISE_RIGHTWARDS_AND_LEFTWARDS_OPEN_CIRCLE_ARROWS_WITH_CIRCLED_ONE_OVERLAY, TokenType::ForIn },
+        { E_THUMBS_UP_SIGN, TokenType::BooleanTrue },
+        { E_THUMBS_DOWN_SIGN, TokenType::BooleanFalse },
+        { E_POLICE_CARS_LIGHT, TokenType::Error },
+        { E_LEFT_ARROW_CURVING_RIGHT, TokenType::If },
+        { E_OK, TokenType::ErrorHandler },
+        { E_GRAPES, TokenType::BlockBegin },
+        { E_WATERMELON, TokenType::BlockEnd },
+        { E_NEW_SIGN, TokenType::New },
+        { E_HAND_POINTING_DOWN, TokenType::This },
+        { E_BIOHAZARD, TokenType::Unsafe },
+        { E_RIGHT_ARROW_CURVING_UP, TokenType::Super },
+        { E_RIGHTWARDS_ARROW, TokenType::RightProductionOperator },
+        { E_LEFTWARDS_ARROW, TokenType::LeftProductionOperator },
+        { E_CRAYON, TokenType::Mutable },
+        { E_SPIRAL_SHELL, TokenType::Generic },
+
+        { E_CROCODILE, TokenType::Protocol },
+        { E_DOVE_OF_PEACE, TokenType::ValueType },
+        { E_RABBIT, TokenType::Class },
+        { E_RADIO_BUTTON, TokenType::Enumeration },
+        { E_CHEERING_MEGAPHONE, TokenType::SelectionOperator },
+        { U'🍿', TokenType::CollectionLiteral },
+    };
+    return singleTokens;
+}
+
 Lexer::Lexer(SourceFile *source, bool minimalMode)
         : sourcePosition_(1, 0, source), source_(source), minimalMode_(minimalMode) {
+    if (source_->file().empty()) {
+        continue_ = false;
+        return;
+    }
+    decodeCodePoint();
     skipWhitespace();
-
-    loadOperatorSingleTokens();
-    singleTokens_.emplace(E_RED_EXCLAMATION_MARK, TokenType::EndArgumentList);
-    singleTokens_.emplace(E_RED_QUESTION_MARK, TokenType::EndInterrogativeArgumentList);
-    singleTokens_.emplace(E_RIGHT_FACING_FIST, TokenType::GroupBegin);
-    singleTokens_.emplace(E_LEFT_FACING_FIST, TokenType::GroupEnd);
-    singleTokens_.emplace(E_RIGHT_ARROW_CURVING_LEFT, TokenType::Return);
-    singleTokens_.emplace(E_CLOCKWISE_RIGHTWARDS_AND_LEFTWARDS_OPEN_CIRCLE_ARROWS, TokenType::RepeatWhile);
-    singleTokens_.emplace(E_CLOCKWISE_RIGHTWARDS_AND_LEFTWARDS_OPEN_CIRCLE_ARROWS_WITH_CIRCLED_ONE_OVERLAY,
-                          TokenType::ForIn);
-    singleTokens_.emplace(E_THUMBS_UP_SIGN, TokenType::BooleanTrue);
-    singleTokens_.emplace(E_THUMBS_DOWN_SIGN, TokenType::BooleanFalse);
-    singleTokens_.emplace(E_POLICE_CARS_LIGHT, TokenType::Error);
-    singleTokens_.emplace(E_LEFT_ARROW_CURVING_RIGHT, TokenType::If);
-    singleTokens_.emplace(E_OK, TokenType::ErrorHandler);
-    singleTokens_.emplace(E_GRAPES, TokenType::BlockBegin);
-    singleTokens_.emplace(E_WATERMELON, TokenType::BlockEnd);
-    singleTokens_.emplace(E_NEW_SIGN, TokenType::New);
-    singleTokens_.emplace(E_HAND_POINTING_DOWN, TokenType::This);
-    singleTokens_.emplace(E_BIOHAZARD, TokenType::Unsafe);
-    singleTokens_.emplace(E_RIGHT_ARROW_CURVING_UP, TokenType::Super);
-    singleTokens_.emplace(E_RIGHTWARDS_ARROW, TokenType::RightProductionOperator);
-    singleTokens_.emplace(E_LEFTWARDS_ARROW, TokenType::LeftProductionOperator);
-    singleTokens_.emplace(E_CRAYON, TokenType::Mutable);
-    singleTokens_.emplace(E_SPIRAL_SHELL, TokenType::Generic);
-
-    singleTokens_.emplace(E_CROCODILE, TokenType::Protocol);
-    singleTokens_.emplace(E_DOVE_OF_PEACE, TokenType::ValueType);
-    singleTokens_.emplace(E_RABBIT, TokenType::Class);
-    singleTokens_.emplace(E_RADIO_BUTTON, TokenType::Enumeration);
-    singleTokens_.emplace(E_CHEERING_MEGAPHONE, TokenType::SelectionOperator);
-    singleTokens_.emplace(U'🍿', TokenType::CollectionLiteral);
 }
 
-void Lexer::loadOperatorSingleTokens() {
-    singleTokens_.emplace(E_HEAVY_PLUS_SIGN, TokenType::Operator);
-    singleTokens_.emplace(E_HEAVY_MINUS_SIGN, TokenType::Operator);
-    singleTokens_.emplace(E_HEAVY_DIVISION_SIGN, TokenType::Operator);
-    singleTokens_.emplace(E_HEAVY_MULTIPLICATION_SIGN, TokenType::Operator);
-    singleTokens_.emplace(E_OPEN_HANDS, TokenType::Operator);
-    singleTokens_.emplace(E_HANDSHAKE, TokenType::Operator);
-    singleTokens_.emplace(E_HEAVY_LARGE_CIRCLE, TokenType::Operator);
-    singleTokens_.emplace(E_ANGER_SYMBOL, TokenType::Operator);
-    singleTokens_.emplace(E_CROSS_MARK, TokenType::Operator);
-    singleTokens_.emplace(E_LEFT_POINTING_BACKHAND_INDEX, TokenType::Operator);
-    singleTokens_.emplace(E_RIGHT_POINTING_BACKHAND_INDEX, TokenType::Operator);
-    singleTokens_.emplace(E_PUT_LITTER_IN_ITS_SPACE, TokenType::Operator);
-    singleTokens_.emplace(E_HANDS_RAISED_IN_CELEBRATION, TokenType::Operator);
-    singleTokens_.emplace(E_FACE_WITH_STUCK_OUT_TONGUE_AND_WINKING_EYE, TokenType::Operator);
-    singleTokens_.emplace(E_RED_EXCLAMATION_MARK_AND_QUESTION_MARK, TokenType::Call);
+void Lexer::decodeCodePoint() {
+    auto bytes = reinterpret_cast<const unsigned char *>(source_->file().data());
+    auto size = source_->file().size();
+    unsigned char lead = bytes[i_];
+    if (lead < 0x80) {
+        codePoint_ = lead;
+        next_ = i_ + 1;
+        return;
+    }
+
+    size_t length;
+    char32_t minimum;
+    if ((lead & 0xE0) == 0xC0) {
+        length = 2;
+        minimum = 0x80;
+        codePoint_ = lead & 0x1F;
+    }
+    else if ((lead & 0xF0) == 0xE0) {
+        length = 3;
+        minimum = 0x800;
+        codePoint_ = lead & 0x0F;
+    }
+    else if ((lead & 0xF8) == 0xF0) {
+        length = 4;
+        minimum = 0x10000;
+        codePoint_ = lead & 0x07;
+    }
+    else {
+        throw CompilerError(sourcePosition_, "Invalid UTF-8 in source file.");
+    }
+    if (i_ + length > size) {
+        throw CompilerError(sourcePosition_, "Invalid UTF-8 in source file.");
+    }
+    for (size_t j = 1; j < length; j++) {
+        if ((bytes[i_ + j] & 0xC0) != 0x80) {
+            throw CompilerError(sourcePosition_, "Invalid UTF-8 in source file.");
+        }
+        codePoint_ = (codePoint_ << 6) | (bytes[i_ + j] & 0x3F);
+    }
+    if (codePoint_ < minimum || codePoint_ > 0x10FFFF || (0xD800 <= codePoint_ && codePoint_ <= 0xDFFF)) {
+        throw CompilerError(sourcePosition_, "Invalid UTF-8 in source file.");
+    }
+    next_ = i_ + length;
 }
 
 void Lexer::skipWhitespace() {
@@ -79,7 +143,7 @@ bool Lexer::detectWhitespace() {
         sourcePosition_.character = 0;
         sourcePosition_.line++;
         if (!minimalMode_) {
-            source_->endLine(i_ + 1);
+            source_->endLine(next_);
         }
         return false;
     }
@@ -90,7 +154,8 @@ void Lexer::nextChar() {
     if (!hasMoreChars()) {
         throw CompilerError(sourcePosition_, "Unexpected end of file.");
     }
-    i_++;
+    i_ = next_;
+    decodeCodePoint();
     sourcePosition_.character++;
 }
 
@@ -136,11 +201,14 @@ Token Lexer::readToken() {
 }
 
 bool Lexer::beginToken(Token *token, TokenConstructionState *constState) const {
-    auto it = singleTokens_.find(codePoint());
-    if (it != singleTokens_.end()) {
-        token->type_ = it->second;
-        token->value_.push_back(codePoint());
-        return false;
+    // All single tokens are emojis, so ASCII characters need not be looked up.
+    if (codePoint() >= 0x80) {
+        auto it = singleTokens().find(codePoint());
+        if (it != singleTokens().end()) {
+            token->type_ = it->second;
+            token->value_.push_back(codePoint());
+            return false;
+        }
     }
 
     switch (codePoint()) {
@@ -179,7 +247,7 @@ bool Lexer::beginToken(Token *token, TokenConstructionState *constState) const {
         return hasMoreChars();
     }
 
-    if (('0' <= codePoint() && codePoint() <= '9') || codePoint() == '-' || codePoint() == '+') {
+    if (isAscii(kAsciiDigit) || codePoint() == '-' || codePoint() == '+') {
         token->type_ = TokenType::Integer;
         constState->isHex_ = false;
     }
@@ -281,7 +349,7 @@ Lexer::TokenState Lexer::continueSingleLineToken(Token *token, TokenConstruction
 }
 
 Lexer::TokenState Lexer::continueDoubleToken(Token *token) const {
-    if ('0' <= codePoint() && codePoint() <= '9') {
+    if (isAscii(kAsciiDigit)) {
         token->value_.push_back(codePoint());
         return TokenState::Continues;
     }
@@ -300,7 +368,7 @@ Lexer::TokenState Lexer::continueVariableToken(Token *token) const {
 }
 
 Lexer::TokenState Lexer::continueIntegerToken(Token *token, Lexer::TokenConstructionState *constState) const {
-    if (('0' <= codePoint() && codePoint() <= '9') ||
+    if (isAscii(kAsciiDigit) ||
         (((64 < codePoint() && codePoint() < 71) || (96 < codePoint() && codePoint() < 103)) &&
          constState->isHex_)) {
         token->value_.push_back(codePoint());
@@ -10,9 +10,12 @@
 #define Lexer_hpp
 
 #include "Token.hpp"
+#include "TokenSource.hpp"
 #include "SourceManager.hpp"
-#include <map>
+#include <array>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 
 namespace EmojicodeCompiler {
 
@@ -24,7 +27,10 @@ namespace EmojicodeCompiler {
 /// Lexer is normally not directly accessed but used through TokenStream, which provides a more convenient interface.
 ///
 /// Lexer also returns tokens representing comments and line breaks.
-class Lexer {
+///
+/// The Lexer works directly on the UTF-8 encoded content of the file and decodes one code point at a time. ASCII
+/// characters, which make up most whitespace, comments and literals, are classified with a table.
+class Lexer : public TokenSource {
 public:
     /// @param sourceCode The Emojicode source code that shall be analyzed.
     /// @param minimalMode In minimal mode comments and line endings are discarded.
@@ -33,15 +39,16 @@ public:
     /// @returns The next token.
     /// @throws CompilerError if an error occurs during tokenization.
     /// @pre continues() must be true.
-    Token lex();
+    Token lex() override;
 
     /// @returns True iff characters to be tokenized are left.
-    bool continues() const { return continue_; }
+    bool continues() const override { return continue_; }
 
     /// @returns The position which would be the position of the next token returned by lex().
-    const SourcePosition& position() const { return sourcePosition_; }
+    const SourcePosition& position() const override { return sourcePosition_; }
 
-    size_t index() const { return i_; };
+    /// @returns The byte offset in the file at which the next token returned by lex() begins.
+    size_t index() const override { return i_; };
 
 private:
     enum class TokenState {
@@ -55,7 +62,8 @@ private:
         bool commentDetermined_ = false;
     };
 
-    void loadOperatorSingleTokens();
+    /// @returns The tokens that consist of a single emoji, like 🍇.
+    static const std::unordered_map<char32_t, TokenType>& singleTokens();
 
     /// Checks for a whitespace character and updates ::sourcePosition_.
     /// @returns True if @c is whitespace according to isWhitespace().
@@ -76,15 +84,29 @@ private:
     /// another call to beginToken(), if ::continue_ is true.
     Token readToken();
 
-    bool isNewline() const { return codePoint() == 0x0A || codePoint() == 0x2028 || codePoint() == 0x2029; }
+    /// Classes of ASCII characters, which are looked up in kAsciiClasses.
+    enum AsciiClass : uint8_t {
+        kAsciiWhitespace = 1, kAsciiNewline = 2, kAsciiDigit = 4,
+    };
+    static const std::array<uint8_t, 128> kAsciiClasses;
+
+    bool isAscii(AsciiClass asciiClass) const {
+        return codePoint() < 0x80 && (kAsciiClasses[codePoint()] & asciiClass) != 0;
+    }
+
+    bool isNewline() const {
+        return codePoint() < 0x80 ? isAscii(kAsciiNewline) : codePoint() == 0x2028 || codePoint() == 0x2029;
+    }
 
     /// @returns True if the code point is  a whitespace character.
     /// See http://www.unicode.org/Public/6.3.0/ucd/PropList.txt
     bool isWhitespace() const {
-        return (0x9 <= codePoint() && codePoint() <= 0xD) || codePoint() == 0x20 || codePoint() == 0x85
-               || codePoint() == 0xA0 || codePoint() == 0x1680 || (0x2000 <= codePoint() && codePoint() <= 0x200A)
-               || codePoint() == 0x2028 || codePoint() == 0x2029 || codePoint() == 0x2029 || codePoint() == 0x202F
-               || codePoint() == 0x205F || codePoint() == 0x3000 || codePoint() == 0xFE0F;
+        if (codePoint() < 0x80) {
+            return isAscii(kAsciiWhitespace);
+        }
+        return codePoint() == 0x85 || codePoint() == 0xA0 || codePoint() == 0x1680
+               || (0x2000 <= codePoint() && codePoint() <= 0x200A) || codePoint() == 0x2028 || codePoint() == 0x2029
+               || codePoint() == 0x202F || codePoint() == 0x205F || codePoint() == 0x3000 || codePoint() == 0xFE0F;
     }
 
     /// Calls nextCharOrEnd() until the codePoint() does not return a whitespace character or the end of the source code
@@ -92,7 +114,11 @@ private:
     void skipWhitespace();
 
     /// @returns The current code point to be examined.
-    char32_t codePoint() const { return source_->file()[i_]; }
+    char32_t codePoint() const { return codePoint_; }
+
+    /// Decodes the UTF-8 encoded code point at ::i_ into ::codePoint_ and sets ::next_ to the offset after it.
+    /// @throws CompilerError if the bytes at ::i_ are not valid UTF-8.
+    void decodeCodePoint();
 
     /// Makes codePoint() provide the next character of the source code.
     /// @throws CompilerError if the end of the source code string was reached, i.e. hasMoreChars() returns false.
@@ -103,13 +129,16 @@ private:
     void nextCharOrEnd();
 
     /// @returns True iff not all characters of the source code string has been tokenized yet.
-    bool hasMoreChars() const { return i_ + 1 < source_->file().size(); }
+    bool hasMoreChars() const { return next_ < source_->file().size(); }
 
     SourcePosition sourcePosition_;
     bool continue_ = true;
     SourceFile *source_;
+    /// The byte offset of codePoint() in the source file.
     size_t i_ = 0;
-    std::map<char32_t, TokenType> singleTokens_;
+    /// The byte offset of the code point after codePoint().
+    size_t next_ = 0;
+    char32_t codePoint_ = 0;
 
     const bool minimalMode_;
 
@@ -6,9 +6,6 @@
 #include "SourceManager.hpp"
 #include "SourcePosition.hpp"
 #include <algorithm>
-#include <codecvt>
-#include <fstream>
-#include <locale>
 
 namespace EmojicodeCompiler {
 
@@ -18,14 +15,12 @@ SourceFile* SourceManager::read(std::string file) {
         return find->second.get();
     }
 
-    std::ifstream f(file, std::ios_base::binary | std::ios_base::in);
-    if (f.fail()) {
+    // The content is kept as UTF-8 and only decoded by the Lexer as it goes.
+    auto buffer = llvm::MemoryBuffer::getFile(file, -1, false);
+    if (!buffer) {
         throw CompilerError(SourcePosition(), "Couldn't read input file ", file, ".");
     }
-
-    auto string = std::string(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
-    std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> conv;
-    auto content = conv.from_bytes(string);
+    auto content = std::move(*buffer);
 
     if (find != cache_.end()) {
         find->second->setContent(std::move(content));
@@ -38,6 +33,26 @@ SourceFile* SourceManager::read(std::string file) {
     return ptr;
 }
 
+SourceFile* SourceManager::add(const std::string &file) {
+    auto find = cache_.find(file);
+    if (find != cache_.end()) {
+        return find->second.get();
+    }
+    auto cache = std::make_unique<SourceFile>(nullptr, file);
+    auto ptr = cache.get();
+    cache_.emplace(file, std::move(cache));
+    return ptr;
+}
+
+std::vector<std::string> SourceManager::paths() const {
+    std::vector<std::string> paths;
+    paths.reserve(cache_.size());
+    for (auto &pair : cache_) {
+        paths.emplace_back(pair.first);
+    }
+    return paths;
+}
+
 void SourceFile::findComments(const SourcePosition &a, const SourcePosition &b,
                               const std::function<void (const Token &)> &comment) const {
     auto end = comments_.upper_bound(std::make_pair(b.line, b.character));
@@ -12,6 +12,7 @@
 #include <memory>
 #include <functional>
 #include "Token.hpp"
+#include <llvm/Support/MemoryBuffer.h>
 
 namespace EmojicodeCompiler {
 
@@ -19,8 +20,10 @@ struct SourcePosition;
 
 class SourceFile {
 public:
-    explicit SourceFile(std::u32string file, std::string path) : content_(std::move(file)), path_(std::move(path)) {}
-    const std::u32string& file() const { return content_; }
+    SourceFile(std::unique_ptr<llvm::MemoryBuffer> content, std::string path)
+        : content_(std::move(content)), path_(std::move(path)) {}
+    /// @returns The UTF-8 encoded content of the file. Indices into the file, like those in lines(), are byte offsets.
+    llvm::StringRef file() const { return content_ == nullptr ? llvm::StringRef() : content_->getBuffer(); }
     const std::string& path() const { return path_; }
 
     void endLine(size_t end) { lines_.emplace_back(end); }
@@ -34,16 +37,17 @@ public:
                       const std::function<void (const Token &)> &comment) const;
 
     /// Clears the file content from memory.
-    void clearContent() { content_ = U""; }
+    void clearContent() { content_ = nullptr; }
 
-    void setContent(std::u32string content) { content_ = std::move(content); }
+    void setContent(std::unique_ptr<llvm::MemoryBuffer> content) { content_ = std::move(content); }
 
-    bool wasCleared() const { return content_.empty(); }
+    bool wasCleared() const { return content_ == nullptr; }
 
     bool hasNoLines() const { return wasCleared() || lines_.size() == 1; }
 
 private:
-    std::u32string content_;
+    /// Large files are mapped into memory instead of being read.
+    std::unique_ptr<llvm::MemoryBuffer> content_;
     const std::string path_;
     std::vector<size_t> lines_ = {0};
     std::map<std::pair<size_t, size_t>, Token> comments_;
@@ -57,6 +61,13 @@ public:
     /// @param file Path to the source file.
     SourceFile* read(std::string file);
 
+    /// Registers the file at the provided path without reading it, e.g. because its tokens are read from a token
+    /// cache. The returned file has no content.
+    SourceFile* add(const std::string &file);
+
+    /// @returns The paths of all files that were read.
+    std::vector<std::string> paths() const;
+
 private:
     std::map<std::string, std::unique_ptr<SourceFile>> cache_;
 };
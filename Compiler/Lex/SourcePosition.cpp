@@ -12,15 +12,15 @@
 
 namespace EmojicodeCompiler {
 
-std::u32string SourcePosition::wholeLine() const {
+std::string SourcePosition::wholeLine() const {
     if (file == nullptr || file->hasNoLines()) {
-        return std::u32string();
+        return std::string();
     }
 
     auto begin = file->lines()[line - 1];
     auto length = line < file->lines().size() ? file->lines()[line] - begin
-                                              : file->file().find_first_of('\n', begin) + 1 - begin;
-    return file->file().substr(begin, length);
+                                              : file->file().find('\n', begin) + 1 - begin;
+    return file->file().substr(begin, length).str();
 }
 
 std::string SourcePosition::toRuntimeString() const {
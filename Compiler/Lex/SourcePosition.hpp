@@ -32,9 +32,9 @@ struct SourcePosition {
     /// The file into which the this position points. nullptr if the position is unknown.
     SourceFile *file;
 
-    /// @returns The line into which this SourcePosition points or an empty string if the line cannot be
+    /// @returns The UTF-8 encoded line into which this SourcePosition points or an empty string if the line cannot be
     /// returned for whatever reason.
-    std::u32string wholeLine() const;
+    std::string wholeLine() const;
 
     /// @returns A string describing the location for use at runtime.
     std::string toRuntimeString() const;
@@ -16,6 +16,7 @@
 namespace EmojicodeCompiler {
 
 class Lexer;
+class TokenCacheReader;
 
 enum class TokenType {
     NoType,
@@ -77,6 +78,7 @@ enum class TokenType {
 
 class Token {
     friend Lexer;
+    friend TokenCacheReader;
 public:
     explicit Token(SourcePosition p) : position_(std::move(p)) {}
 
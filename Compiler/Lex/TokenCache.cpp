@@ -0,0 +1,154 @@
+#include "TokenCache.hpp"
+#include "CompilerError.hpp"
+#include "Lexer.hpp"
+#include "SourceManager.hpp"
+#include <cstring>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+namespace EmojicodeCompiler {
+
+/// The last byte is the version of the format, which must be incremented whenever TokenType changes.
+static const char kMagic[8] = { 'E', 'J', 'C', 'T', 'O', 'K', 'S', 1 };
+static const uint32_t kByteOrderMark = 0x01020304;
+/// The magic, the byte order mark and the size of the interface in bytes.
+static const size_t kHeaderSize = sizeof(kMagic) + sizeof(uint32_t) + sizeof(uint64_t);
+/// Every token begins with its type, line and character followed by the length of its UTF-8 encoded value in bytes.
+static const size_t kTokenHeaderSize = sizeof(uint8_t) + 3 * sizeof(uint32_t);
+
+template <typename T>
+static void write(llvm::raw_ostream &out, T value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+static T read(const char *pointer) {
+    T value;
+    std::memcpy(&value, pointer, sizeof(T));
+    return value;
+}
+
+std::string tokenCachePath(const std::string &interfacePath) {
+    return interfacePath + ".tokens";
+}
+
+void writeTokenCache(const std::string &interfacePath) {
+    auto buffer = llvm::MemoryBuffer::getFile(interfacePath, -1, false);
+    if (!buffer) {
+        throw CompilerError(SourcePosition(), "Couldn't read interface ", interfacePath, ".");
+    }
+    auto size = (*buffer)->getBufferSize();
+    SourceFile file(std::move(*buffer), interfacePath);
+
+    std::error_code errorCode;
+    llvm::raw_fd_ostream out(tokenCachePath(interfacePath), errorCode, llvm::sys::fs::F_None);
+    if (errorCode) {
+        throw CompilerError(SourcePosition(), "Couldn't write token cache ", tokenCachePath(interfacePath), ": ",
+                            errorCode.message());
+    }
+    out.write(kMagic, sizeof(kMagic));
+    write<uint32_t>(out, kByteOrderMark);
+    write<uint64_t>(out, size);
+
+    // Imported packages are lexed in minimal mode.
+    Lexer lexer(&file, true);
+    while (lexer.continues()) {
+        auto token = lexer.lex();
+        // TokenStream skips line breaks anyway.
+        if (token.type() == TokenType::LineBreak) {
+            continue;
+        }
+        write<uint8_t>(out, static_cast<uint8_t>(token.type()));
+        write<uint32_t>(out, token.position().line);
+        write<uint32_t>(out, token.position().character);
+        auto value = utf8(token.value());
+        write<uint32_t>(out, value.size());
+        out.write(value.data(), value.size());
+    }
+}
+
+std::unique_ptr<TokenCacheReader> TokenCacheReader::open(const std::string &interfacePath,
+                                                         SourceManager *sourceManager) {
+    llvm::sys::fs::file_status interfaceStatus, cacheStatus;
+    if (llvm::sys::fs::status(interfacePath, interfaceStatus) ||
+        llvm::sys::fs::status(tokenCachePath(interfacePath), cacheStatus) ||
+        cacheStatus.getLastModificationTime() < interfaceStatus.getLastModificationTime()) {
+        return nullptr;
+    }
+    auto buffer = llvm::MemoryBuffer::getFile(tokenCachePath(interfacePath), -1, false);
+    if (!buffer || (*buffer)->getBufferSize() < kHeaderSize) {
+        return nullptr;
+    }
+    auto begin = (*buffer)->getBufferStart();
+    if (std::memcmp(begin, kMagic, sizeof(kMagic)) != 0 ||
+        read<uint32_t>(begin + sizeof(kMagic)) != kByteOrderMark ||
+        read<uint64_t>(begin + sizeof(kMagic) + sizeof(uint32_t)) != interfaceStatus.getSize()) {
+        return nullptr;
+    }
+    auto file = sourceManager->add(interfacePath);
+    return std::unique_ptr<TokenCacheReader>(new TokenCacheReader(std::move(*buffer), begin + kHeaderSize, file));
+}
+
+TokenCacheReader::TokenCacheReader(std::unique_ptr<llvm::MemoryBuffer> buffer, const char *begin, SourceFile *file)
+        : buffer_(std::move(buffer)), next_(begin), end_(buffer_->getBufferEnd()), position_(1, 0, file) {
+    if (continues()) {
+        readPosition();
+    }
+}
+
+void TokenCacheReader::checkAvailable(size_t bytes) const {
+    if (static_cast<size_t>(end_ - next_) < bytes) {
+        corrupt();
+    }
+}
+
+void TokenCacheReader::corrupt() const {
+    throw CompilerError(position_, "The token cache ", tokenCachePath(position_.file->path()),
+                        " is corrupt. Delete it to lex the interface instead.");
+}
+
+void TokenCacheReader::readPosition() {
+    checkAvailable(kTokenHeaderSize);
+    position_.line = read<uint32_t>(next_ + sizeof(uint8_t));
+    position_.character = read<uint32_t>(next_ + sizeof(uint8_t) + sizeof(uint32_t));
+}
+
+Token TokenCacheReader::lex() {
+    Token token(position_);
+    auto type = read<uint8_t>(next_);
+    if (type > static_cast<uint8_t>(TokenType::CollectionLiteral)) {
+        corrupt();
+    }
+    token.type_ = static_cast<TokenType>(type);
+    auto length = read<uint32_t>(next_ + sizeof(uint8_t) + 2 * sizeof(uint32_t));
+    next_ += kTokenHeaderSize;
+    checkAvailable(length);
+    auto bytes = reinterpret_cast<const unsigned char *>(next_);
+    token.value_.reserve(length);
+    // The value was encoded by writeTokenCache() and is therefore valid UTF-8.
+    for (size_t i = 0; i < length;) {
+        unsigned char lead = bytes[i];
+        if (lead < 0x80) {
+            token.value_.push_back(lead);
+            i++;
+            continue;
+        }
+        size_t size = lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : 2;
+        if (i + size > length) {
+            corrupt();
+        }
+        char32_t codePoint = lead & (0x7F >> size);
+        for (size_t j = 1; j < size; j++) {
+            codePoint = (codePoint << 6) | (bytes[i + j] & 0x3F);
+        }
+        token.value_.push_back(codePoint);
+        i += size;
+    }
+    next_ += length;
+    if (continues()) {
+        readPosition();
+    }
+    return token;
+}
+
+}  // namespace EmojicodeCompiler
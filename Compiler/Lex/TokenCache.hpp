@@ -0,0 +1,60 @@
+#ifndef EMOJICODE_TOKENCACHE_HPP
+#define EMOJICODE_TOKENCACHE_HPP
+
+#include "TokenSource.hpp"
+#include <llvm/Support/MemoryBuffer.h>
+#include <memory>
+#include <string>
+
+namespace EmojicodeCompiler {
+
+class SourceFile;
+class SourceManager;
+
+/// @returns The path of the token cache of the package interface at `interfacePath`.
+std::string tokenCachePath(const std::string &interfacePath);
+
+/// Lexes the package interface at `interfacePath` and stores its tokens in a token cache next to it.
+///
+/// A token cache contains the tokens of an interface in a compact binary format. Importing a package whose interface
+/// has an up-to-date token cache does not require lexing the interface. It only replaces the lexer: the tokens are
+/// still parsed and the interface is analysed on every import like any other. The format is specific to the byte
+/// order of the machine that wrote it; caches from a machine with different byte order are ignored.
+/// @throws CompilerError if the cache cannot be written.
+void writeTokenCache(const std::string &interfacePath);
+
+/// Provides the tokens from a token cache. The cache is mapped into memory and tokens are only decoded as they are
+/// requested.
+class TokenCacheReader : public TokenSource {
+public:
+    /// @returns A reader for the token cache of the interface at `interfacePath` or nullptr if there is no cache or
+    /// the cache is out of date, in which case the interface must be lexed.
+    static std::unique_ptr<TokenCacheReader> open(const std::string &interfacePath, SourceManager *sourceManager);
+
+    Token lex() override;
+    bool continues() const override { return next_ < end_; }
+    const SourcePosition& position() const override { return position_; }
+    /// Token caches do not store offsets into the interface, which are not needed for imported packages.
+    size_t index() const override { return 0; }
+
+    /// @returns The interface file to which the positions of the tokens refer. It has no content.
+    SourceFile* file() const { return position_.file; }
+
+private:
+    TokenCacheReader(std::unique_ptr<llvm::MemoryBuffer> buffer, const char *begin, SourceFile *file);
+
+    /// Reads the position of the token at ::next_ into ::position_.
+    void readPosition();
+    /// @throws CompilerError if fewer than `bytes` bytes are left.
+    void checkAvailable(size_t bytes) const;
+    [[noreturn]] void corrupt() const;
+
+    std::unique_ptr<llvm::MemoryBuffer> buffer_;
+    const char *next_;
+    const char *end_;
+    SourcePosition position_;
+};
+
+}  // namespace EmojicodeCompiler
+
+#endif //EMOJICODE_TOKENCACHE_HPP
@@ -0,0 +1,31 @@
+#ifndef EMOJICODE_TOKENSOURCE_HPP
+#define EMOJICODE_TOKENSOURCE_HPP
+
+#include "Token.hpp"
+
+namespace EmojicodeCompiler {
+
+/// A TokenSource provides the tokens of a source file to a TokenStream. Usually, this is a Lexer but the tokens of a
+/// package interface can also be read from a token cache (see TokenCacheReader).
+class TokenSource {
+public:
+    /// @returns The next token.
+    /// @throws CompilerError if the next token cannot be provided.
+    /// @pre continues() must be true.
+    virtual Token lex() = 0;
+
+    /// @returns True iff more tokens are left.
+    virtual bool continues() const = 0;
+
+    /// @returns The position which would be the position of the next token returned by lex().
+    virtual const SourcePosition& position() const = 0;
+
+    /// @returns The byte offset in the file at which the next token returned by lex() begins.
+    virtual size_t index() const = 0;
+
+    virtual ~TokenSource() = default;
+};
+
+}  // namespace EmojicodeCompiler
+
+#endif //EMOJICODE_TOKENSOURCE_HPP
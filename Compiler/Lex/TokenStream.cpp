@@ -8,19 +8,20 @@
 
 #include "TokenStream.hpp"
 #include "CompilerError.hpp"
+#include "SourceManager.hpp"
 
 namespace EmojicodeCompiler {
 
 Token TokenStream::consumeToken() {
     if (!hasMoreTokens()) {
-        throw CompilerError(lexer_.position(), "Unexpected end of program.");
+        throw CompilerError(source_->position(), "Unexpected end of program.");
     }
     return advanceLexer();
 }
 
 Token TokenStream::consumeToken(TokenType type) {
     if (!hasMoreTokens()) {
-        throw CompilerError(lexer_.position(), "Unexpected end of program.");
+        throw CompilerError(source_->position(), "Unexpected end of program.");
     }
     if (nextToken().type() != type) {
         throw CompilerError(nextToken().position(), "Expected ", Token::stringNameForType(type),
@@ -49,9 +50,9 @@ Token TokenStream::advanceLexer() {
     skippedBlankLine_ = false;
     auto temp = std::move(nextToken_);
     while (true) {
-        if (lexer_.continues()) {
-            index_ = lexer_.index();
-            nextToken_ = lexer_.lex();
+        if (source_->continues()) {
+            index_ = source_->index();
+            nextToken_ = source_->lex();
             if (nextToken_.type() == TokenType::BlankLine) {
                 skippedBlankLine_ = true;
                 continue;
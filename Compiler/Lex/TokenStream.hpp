@@ -9,15 +9,16 @@
 #ifndef TokenStream_hpp
 #define TokenStream_hpp
 
-#include "Lexer.hpp"
+#include "TokenSource.hpp"
+#include <memory>
 
 namespace EmojicodeCompiler {
 
-/// TokenStream provides a convenient interface to Lexer. It allows a lookahead of one token.
+/// TokenStream provides a convenient interface to a TokenSource, usually a Lexer. It allows a lookahead of one token.
 /// TokenStream skips comments and line breaks and provides handling for blank lines.
 class TokenStream {
 public:
-    explicit TokenStream(Lexer lexer) : lexer_(std::move(lexer)) { advanceLexer(); }
+    explicit TokenStream(std::unique_ptr<TokenSource> source) : source_(std::move(source)) { advanceLexer(); }
     TokenStream(const TokenStream&) = delete;
     TokenStream(TokenStream&&) = default;
     TokenStream& operator=(const TokenStream&) = delete;
@@ -74,7 +75,7 @@ private:
 
     bool moreTokens_ = true;
     bool skippedBlankLine_ = false;
-    Lexer lexer_;
+    std::unique_ptr<TokenSource> source_;
     Token nextToken_ = Token(SourcePosition());
     size_t index_ = 0;
 };
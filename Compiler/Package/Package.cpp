@@ -11,6 +11,7 @@
 #include "CompilerError.hpp"
 #include "Lex/Lexer.hpp"
 #include "Lex/SourceManager.hpp"
+#include "Lex/TokenCache.hpp"
 #include "Package.hpp"
 #include "Parsing/DocumentParser.hpp"
 #include "Types/Class.hpp"
@@ -76,8 +77,15 @@ std::pair<SourceFile*, TokenStream> Package::lexFile(const std::string &path) {
         throw CompilerError(SourcePosition(), "Emojicode files must have a filename: ", path);
     }
 
+    if (isImported()) {
+        // Only lexing is skipped, the interface is parsed and analysed as usual.
+        if (auto cache = TokenCacheReader::open(path, &compiler()->sourceManager())) {
+            auto file = cache->file();
+            return std::make_pair(file, TokenStream(std::move(cache)));
+        }
+    }
     auto file = compiler()->sourceManager().read(path);
-    return std::make_pair(file, TokenStream(Lexer(file, isImported())));
+    return std::make_pair(file, TokenStream(std::make_unique<Lexer>(file, isImported())));
 }
 
 void Package::includeDocument(const std::string &path, const std::string &relativePath) {
@@ -20,6 +20,7 @@
 #include "Scoping/Scope.hpp"
 #include <algorithm>
 #include <iostream>
+#include <llvm/Support/ConvertUTF.h>
 
 namespace EmojicodeCompiler {
 
@@ -380,8 +381,9 @@ void PrettyPrinter::printBody(Function *function) {
         if (interface_) {
             if (function->isInline()) {
                 auto str = function->position().file->file();
-                auto code = str.substr(function->ast()->beginIndex(),
-                                       function->ast()->endIndex() - function->ast()->beginIndex() + 1);
+                // The end index is the byte offset of the closing 🍉, which must be included entirely.
+                auto end = function->ast()->endIndex() + llvm::getNumBytesForUTF8(str[function->ast()->endIndex()]);
+                auto code = str.substr(function->ast()->beginIndex(), end - function->ast()->beginIndex()).str();
                 prettyStream_ << " 🍇\n";
                 prettyStream_.increaseIndent();
                 prettyStream_.indent() << code;
@@ -22,7 +22,7 @@ void Variable::mutate(const SourcePosition &p) {
         }
         throw ce;
     }
-    mutated_ = true;
+    mutated_.store(true, std::memory_order_relaxed);
 }
 
 }  // namespace EmojicodeCompiler
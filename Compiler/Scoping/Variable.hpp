@@ -9,6 +9,7 @@
 #ifndef Variable_hpp
 #define Variable_hpp
 
+#include <atomic>
 #include <utility>
 #include "Lex/SourcePosition.hpp"
 #include "Types/Type.hpp"
@@ -24,6 +25,20 @@ class Variable {
 public:
     Variable(Type type, VariableID id, bool constant, std::u32string string, SourcePosition p)
         : type_(std::move(type)), constant_(constant), string_(std::move(string)), id_(id), position_(std::move(p)) {}
+    Variable(const Variable &other)
+        : type_(other.type_), constant_(other.constant_), mutated_(other.mutated()), inherited_(other.inherited_),
+          captured_(other.captured_), string_(other.string_), id_(other.id_), position_(other.position_) {}
+    Variable& operator=(const Variable &other) {
+        type_ = other.type_;
+        constant_ = other.constant_;
+        mutated_.store(other.mutated(), std::memory_order_relaxed);
+        inherited_ = other.inherited_;
+        captured_ = other.captured_;
+        string_ = other.string_;
+        id_ = other.id_;
+        position_ = other.position_;
+        return *this;
+    }
     /// The type of the variable.
     const Type type() const { return type_; }
 
@@ -33,12 +48,13 @@ public:
     /// The position at which this variable was defined
     const SourcePosition& position() const { return position_; }
 
-    /// Marks the variable as mutated or issues an error if the variable is constant.
+    /// Marks the variable as mutated or issues an error if the variable is constant. Thread-safe, as instance
+    /// variables are shared by all methods of a type, whose bodies may be analysed concurrently.
     /// @throws CompilerError if the variable is constant.
     void mutate(const SourcePosition &p);
 
     /// Whether the variable was mutated since its definition.
-    bool mutated() const { return mutated_; }
+    bool mutated() const { return mutated_.load(std::memory_order_relaxed); }
 
     /// Whether this is a constant variable.
     bool constant() const { return constant_; }
@@ -53,7 +69,7 @@ public:
 private:
     Type type_;
     bool constant_;
-    bool mutated_ = false;
+    std::atomic<bool> mutated_ { false };
     bool inherited_ = false;
     bool captured_ = false;
     std::u32string string_;
@@ -0,0 +1,54 @@
+#include "Timing.hpp"
+#include "Allocations.hpp"
+#include <chrono>
+#include <sys/resource.h>
+
+namespace EmojicodeCompiler {
+
+static double wallTime() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration<double>(now).count();
+}
+
+static double seconds(const timeval &time) {
+    return time.tv_sec + time.tv_usec / 1e6;
+}
+
+static double cpuTime() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return seconds(usage.ru_utime) + seconds(usage.ru_stime);
+}
+
+static size_t peakRss() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss);
+#else
+    // Linux reports kilobytes.
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+void Stopwatch::start() {
+    if (enabled_) {
+        wallStart_ = wallTime();
+        cpuStart_ = cpuTime();
+        allocationsStart_ = allocationCount();
+    }
+}
+
+void Stopwatch::stop() {
+    if (enabled_) {
+        wall_ += wallTime() - wallStart_;
+        cpu_ += cpuTime() - cpuStart_;
+        allocations_ += allocationCount() - allocationsStart_;
+    }
+}
+
+Timing Stopwatch::timing(std::string category, std::string name) const {
+    return Timing(std::move(category), std::move(name), wall_, cpu_, peakRss(), allocations_);
+}
+
+}  // namespace EmojicodeCompiler
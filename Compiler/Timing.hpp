@@ -0,0 +1,55 @@
+#ifndef EMOJICODE_TIMING_HPP
+#define EMOJICODE_TIMING_HPP
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace EmojicodeCompiler {
+
+/// The resources a part of the compilation used. Timings are only recorded if Compiler::enableTiming() was called.
+struct Timing {
+    Timing(std::string category, std::string name, double wall, double cpu, size_t peakRss, size_t allocations)
+        : category(std::move(category)), name(std::move(name)), wall(wall), cpu(cpu), peakRss(peakRss),
+          allocations(allocations) {}
+
+    /// What was measured, i.e. `phase`, `package` or `passes`.
+    std::string category;
+    std::string name;
+    /// The elapsed wall-clock time in seconds.
+    double wall;
+    /// The user and system CPU time in seconds that all threads of the compiler spent.
+    double cpu;
+    /// The peak resident set size of the compiler in bytes at the end of the measurement.
+    size_t peakRss;
+    /// The number of allocations that all threads of the compiler made with operator new.
+    size_t allocations;
+};
+
+/// A Stopwatch measures wall-clock and CPU time and counts allocations. Measurements between several calls to start()
+/// and stop() are added up, which allows timing work that is interleaved with other work, like the function passes.
+///
+/// A disabled Stopwatch does nothing, so that it can be placed on hot paths unconditionally.
+class Stopwatch {
+public:
+    explicit Stopwatch(bool enabled) : enabled_(enabled) {}
+
+    void start();
+    void stop();
+
+    /// @returns A Timing of all measurements made so far.
+    Timing timing(std::string category, std::string name) const;
+
+private:
+    bool enabled_;
+    double wall_ = 0;
+    double cpu_ = 0;
+    double wallStart_ = 0;
+    double cpuStart_ = 0;
+    size_t allocations_ = 0;
+    size_t allocationsStart_ = 0;
+};
+
+}  // namespace EmojicodeCompiler
+
+#endif //EMOJICODE_TIMING_HPP
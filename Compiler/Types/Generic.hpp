@@ -16,7 +16,9 @@
 #include <cassert>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace EmojicodeCompiler {
@@ -32,6 +34,13 @@ struct GenericParameter {
     bool reifies = false;
 };
 
+/// Guards the reifications of all instances of Generic, which are requested from several threads if function bodies
+/// are analysed concurrently. Requests are rare and brief compared to the analysis, so a single mutex suffices.
+inline std::mutex& reificationMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
 template <typename T, typename Entity>
 class Generic {
 public:
@@ -97,6 +106,7 @@ public:
     }
 
     Entity& reificationFor(const std::vector<Type> &arguments) {
+        std::lock_guard<std::mutex> lock(reificationMutex());
         auto ref = reifications_.find(buildKey(arguments));
         assert(ref != reifications_.end());
         return ref->second.entity;
@@ -114,6 +124,7 @@ public:
     /// should only be called in combination with unspecificReification()
     Entity& createUnspecificReification() {
         assert(!requiresCopyReification());
+        std::lock_guard<std::mutex> lock(reificationMutex());
         if (reifications_.empty()) {
             reifications_.emplace();
         }
@@ -155,7 +166,7 @@ public:
         }
     }
 
-    const std::map<std::vector<Type>, Reification>& reificationMap() const { return reifications_; }
+    const std::unordered_map<std::vector<Type>, Reification>& reificationMap() const { return reifications_; }
 
     /// Returns the offset at which this (sub)types arguments are stored (during compilation and run-time).
     size_t offset() const { return offset_; }
@@ -176,7 +187,9 @@ private:
     /** Generic type arguments as variables */
     std::map<std::u32string, size_t> parameterVariables_;
 
-    std::map<std::vector<Type>, Reification> reifications_;
+    /// The reifications by the arguments to the reifying parameters, see buildKey(). Hashed, as reifications are looked
+    /// up for every call to a generic function during code generation.
+    std::unordered_map<std::vector<Type>, Reification> reifications_;
 
     size_t offset_ = 0;
 
@@ -190,12 +203,15 @@ private:
         return key;
     }
 
+    /// Thread-safe.
     void requestReification(const std::vector<Type> &arguments) {
         auto key = buildKey(arguments);
-        if (reifications_.find(key) != reifications_.end()) {
+        std::lock_guard<std::mutex> lock(reificationMutex());
+        auto inserted = reifications_.try_emplace(std::move(key));
+        if (!inserted.second) {
             return;
         }
-        auto &reification = reifications_[key] = Reification();
+        auto &reification = inserted.first->second;
         for (size_t i = 0; i < genericParameters_.size(); i++) {
             if (genericParameters_[i].reifies) {
                 reification.arguments.emplace(i + offset_, arguments[i]);
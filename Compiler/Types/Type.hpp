@@ -10,6 +10,7 @@
 #define Type_hpp
 
 #include "StorageType.hpp"
+#include <functional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -301,22 +302,31 @@ public:
     }
     void setExact(bool b) { forceExact_ = b; }
 
+    /// Types are ordered and compared by their content, type definition, generic variable index and local resolution
+    /// constraint only. Neither generic arguments nor storage flags are considered, which keeps these operations and
+    /// hash() constant-time regardless of how deeply the type is nested.
     inline bool operator<(const Type &rhs) const {
-        return std::tie(typeContent_, typeDefinition_, rhs.genericArguments_, genericArgumentIndex_,
-                        localResolutionConstraint_) < std::tie(rhs.typeContent_, rhs.typeDefinition_,
-                                                               rhs.genericArguments_, rhs.genericArgumentIndex_,
-                                                               rhs.localResolutionConstraint_);
+        return std::tie(typeContent_, typeDefinition_, genericArgumentIndex_, localResolutionConstraint_) <
+               std::tie(rhs.typeContent_, rhs.typeDefinition_, rhs.genericArgumentIndex_,
+                        rhs.localResolutionConstraint_);
     }
 
     inline bool operator==(const Type &rhs) const {
-        return std::tie(typeContent_, typeDefinition_, rhs.genericArguments_, genericArgumentIndex_,
-                        localResolutionConstraint_) == std::tie(rhs.typeContent_, rhs.typeDefinition_,
-                                                                rhs.genericArguments_, rhs.genericArgumentIndex_,
-                                                                rhs.localResolutionConstraint_);
+        return std::tie(typeContent_, typeDefinition_, genericArgumentIndex_, localResolutionConstraint_) ==
+               std::tie(rhs.typeContent_, rhs.typeDefinition_, rhs.genericArgumentIndex_,
+                        rhs.localResolutionConstraint_);
     }
 
     inline bool operator!=(const Type &rhs) const { return !(*this == rhs); }
 
+    /// Returns a hash that is equal for all types that are equal according to operator==.
+    size_t hash() const {
+        auto hash = std::hash<TypeDefinition *>()(typeDefinition_);
+        hash = hash * 31 + static_cast<size_t>(typeContent_);
+        hash = hash * 31 + genericArgumentIndex_;
+        return hash * 31 + std::hash<Function *>()(localResolutionConstraint_);
+    }
+
     /// Returns true iff a value of the given type requires memory management.
     bool isManaged() const;
 
@@ -372,4 +382,24 @@ private:
 
 }  // namespace EmojicodeCompiler
 
+namespace std {
+
+template <>
+struct hash<EmojicodeCompiler::Type> {
+    size_t operator()(const EmojicodeCompiler::Type &type) const { return type.hash(); }
+};
+
+template <>
+struct hash<std::vector<EmojicodeCompiler::Type>> {
+    size_t operator()(const std::vector<EmojicodeCompiler::Type> &types) const {
+        size_t hash = types.size();
+        for (auto &type : types) {
+            hash = hash * 31 + type.hash();
+        }
+        return hash;
+    }
+};
+
+}  // namespace std
+
 #endif /* Type_hpp */
@@ -18,7 +18,13 @@ def copy_packages(destination, source):
         dir_path = os.path.join(destination, package)
         make_dir(dir_path)
         shutil.copy2(os.path.join(package.encode('utf-8'), "🏛".encode('utf-8')), dir_path.encode('utf-8'))
+        token_cache = os.path.join(package.encode('utf-8'), "🏛.tokens".encode('utf-8'))
+        if os.path.exists(token_cache):
+            shutil.copy2(token_cache, dir_path.encode('utf-8'))
         shutil.copy2(os.path.join(package, "lib" + package + ".a"), dir_path)
+        bitcode = os.path.join(package, "lib" + package + ".bc")
+        if os.path.exists(bitcode):
+            shutil.copy2(bitcode, dir_path)
 
 def make_dir(path):
     if not os.path.exists(path):
@@ -0,0 +1,292 @@
+#include "../runtime/Runtime.h"
+#include "../s/ByteOperations.h"
+#include "../s/Data.h"
+#include "../s/Numbers.h"
+#include "../s/String.h"
+#include "Structural.h"
+#include <cstring>
+#include <limits>
+#include <string>
+
+using s::Data;
+using s::String;
+
+namespace json {
+
+/// 🚧🔸🌸, which is raised if a document is not valid JSON.
+class Error : public runtime::Object<Error> {
+public:
+    explicit Error(const std::string &message) : message_(String::init(message.c_str())) {}
+
+private:
+    String *message_;
+    runtime::SimpleOptional<String*> location_ = runtime::NoValue;
+};
+
+/// A JSON document together with its structural index, represented by 🌲. Values in the document are identified by
+/// the number of their entry in the index.
+class Document : public runtime::Object<Document> {
+public:
+    explicit Document(String *string) : string_(string) {
+        string_->retain();
+    }
+    explicit Document(Data *data) : data_(data) {
+        data_->retain();
+    }
+    ~Document() {
+        if (string_ != nullptr) string_->release();
+        if (data_ != nullptr) data_->release();
+    }
+
+    const uint8_t* bytes() const {
+        if (string_ != nullptr) {
+            return reinterpret_cast<const uint8_t *>(string_->characters.get());
+        }
+        return reinterpret_cast<const uint8_t *>(data_->data.get());
+    }
+    size_t count() const { return string_ != nullptr ? string_->count : data_->count; }
+
+    StructuralIndex& index() { return index_; }
+
+private:
+    String *string_ = nullptr;
+    Data *data_ = nullptr;
+    StructuralIndex index_;
+};
+
+/// The values of 🍃.
+enum class Kind : runtime::Enum {
+    Object, Array, String, Number, Boolean, Null
+};
+
+}  // namespace json
+
+SET_INFO_FOR(json::Error, json, 1f6a7_1f538_1f338)
+SET_INFO_FOR(json::Document, json, 1f332)
+
+namespace json {
+
+static Document* build(Document *document, runtime::Raiser *raiser) {
+    if (document->index().build(document->bytes(), document->count())) {
+        return document;
+    }
+    auto message = std::string(document->index().error()) + " (byte " +
+                   std::to_string(document->index().errorOffset()) + ")";
+    document->release();
+    EJC_RAISE(raiser, Error::init(message));
+}
+
+extern "C" Document* jsonDocumentNew(String *string, runtime::Raiser *raiser) {
+    return build(Document::init(string), raiser);
+}
+
+extern "C" Document* jsonDocumentNewData(Data *data, runtime::Raiser *raiser) {
+    auto begin = reinterpret_cast<const uint8_t *>(data->data.get());
+    if (!s::bytes::isValidUTF8(begin, begin + data->count)) {
+        EJC_RAISE(raiser, Error::init("The document is not valid UTF-8."));
+    }
+    return build(Document::init(data), raiser);
+}
+
+extern "C" void jsonDocumentDestruct(Document *document) {
+    document->~Document();
+}
+
+extern "C" runtime::Enum jsonDocumentKind(Document *document, runtime::Integer entry) {
+    switch (document->index().byte(entry)) {
+        case '{': return static_cast<runtime::Enum>(Kind::Object);
+        case '[': return static_cast<runtime::Enum>(Kind::Array);
+        case '"': return static_cast<runtime::Enum>(Kind::String);
+        case 't': case 'f': return static_cast<runtime::Enum>(Kind::Boolean);
+        case 'n': return static_cast<runtime::Enum>(Kind::Null);
+        default: return static_cast<runtime::Enum>(Kind::Number);
+    }
+}
+
+extern "C" runtime::Boolean jsonDocumentBoolean(Document *document, runtime::Integer entry) {
+    return document->index().byte(entry) == 't';
+}
+
+extern "C" runtime::SimpleOptional<runtime::Integer> jsonDocumentFirst(Document *document, runtime::Integer entry) {
+    auto &index = document->index();
+    auto c = index.byte(entry);
+    if ((c != '{' && c != '[') || index.after(entry) == static_cast<size_t>(entry) + 2) {
+        return runtime::NoValue;
+    }
+    return entry + 1;
+}
+
+extern "C" runtime::SimpleOptional<runtime::Integer> jsonDocumentNext(Document *document, runtime::Integer child) {
+    auto &index = document->index();
+    // The value of an object member follows its key and the colon.
+    auto value = index.byte(child + 1) == ':' ? child + 2 : child;
+    auto next = index.after(value);
+    if (index.byte(next) != ',') {
+        return runtime::NoValue;
+    }
+    return static_cast<runtime::Integer>(next + 1);
+}
+
+/// Decodes the contents of the string that begins at `entry` to `destination`, which must have room for as many bytes
+/// as the encoded string.
+/// @returns The number of bytes written.
+static size_t unescape(StructuralIndex &index, const uint8_t *bytes, runtime::Integer entry, char *destination) {
+    auto pos = bytes + index.offset(entry) + 1, end = bytes + index.stringEnd(entry);
+    auto out = destination;
+    while (pos < end) {
+        auto backslash = s::bytes::find(pos, end, '\\');
+        if (backslash == nullptr) {
+            backslash = end;
+        }
+        std::memcpy(out, pos, backslash - pos);
+        out += backslash - pos;
+        pos = backslash;
+        if (pos == end) {
+            break;
+        }
+
+        // The index has already validated the escape sequence.
+        switch (pos[1]) {
+            case 'b': *out++ = '\b'; break;
+            case 'f': *out++ = '\f'; break;
+            case 'n': *out++ = '\n'; break;
+            case 'r': *out++ = '\r'; break;
+            case 't': *out++ = '\t'; break;
+            case 'u': {
+                auto hex = [](const uint8_t *digits) {
+                    uint32_t value = 0;
+                    for (size_t i = 0; i < 4; i++) {
+                        auto d = digits[i];
+                        value = value * 16 + (d <= '9' ? d - '0' : (d | 0x20) - 'a' + 10);
+                    }
+                    return value;
+                };
+                auto codePoint = hex(pos + 2);
+                if (0xD800 <= codePoint && codePoint <= 0xDBFF && end - pos >= 12 && pos[6] == '\\' &&
+                    pos[7] == 'u') {
+                    auto low = hex(pos + 8);
+                    if (0xDC00 <= low && low <= 0xDFFF) {
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                        pos += 6;
+                    }
+                }
+                if (0xD800 <= codePoint && codePoint <= 0xDFFF) {
+                    codePoint = 0xFFFD;
+                }
+                if (codePoint < 0x80) {
+                    *out++ = static_cast<char>(codePoint);
+                }
+                else if (codePoint < 0x800) {
+                    *out++ = static_cast<char>(0xC0 | codePoint >> 6);
+                    *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+                }
+                else if (codePoint < 0x10000) {
+                    *out++ = static_cast<char>(0xE0 | codePoint >> 12);
+                    *out++ = static_cast<char>(0x80 | (codePoint >> 6 & 0x3F));
+                    *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+                }
+                else {
+                    *out++ = static_cast<char>(0xF0 | codePoint >> 18);
+                    *out++ = static_cast<char>(0x80 | (codePoint >> 12 & 0x3F));
+                    *out++ = static_cast<char>(0x80 | (codePoint >> 6 & 0x3F));
+                    *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+                }
+                pos += 4;
+                break;
+            }
+            default: *out++ = static_cast<char>(pos[1]);
+        }
+        pos += 2;
+    }
+    return out - destination;
+}
+
+extern "C" String* jsonDocumentString(Document *document, runtime::Integer entry) {
+    auto &index = document->index();
+    auto length = index.stringEnd(entry) - index.offset(entry) - 1;
+    auto string = String::init();
+    string->characters = runtime::allocate<char>(length);
+    string->count = unescape(index, document->bytes(), entry, string->characters.get());
+    return string;
+}
+
+extern "C" runtime::SimpleOptional<runtime::Integer> jsonDocumentFind(Document *document, runtime::Integer entry,
+                                                                      String *key) {
+    auto &index = document->index();
+    if (index.byte(entry) != '{') {
+        return runtime::NoValue;
+    }
+    auto bytes = document->bytes();
+    std::string decoded;
+    for (auto member = jsonDocumentFirst(document, entry); !(member == runtime::NoValue);
+         member = jsonDocumentNext(document, *member)) {
+        auto begin = bytes + index.offset(*member) + 1;
+        auto length = index.stringEnd(*member) - index.offset(*member) - 1;
+        if (s::bytes::find(begin, begin + length, '\\') != nullptr) {
+            // Keys with escape sequences are decoded before they are compared.
+            decoded.resize(length);
+            decoded.resize(unescape(index, bytes, *member, &decoded[0]));
+            begin = reinterpret_cast<const uint8_t *>(decoded.data());
+            length = decoded.size();
+        }
+        if (static_cast<runtime::Integer>(length) == key->count &&
+            std::memcmp(begin, key->characters.get(), length) == 0) {
+            return *member + 2;
+        }
+    }
+    return runtime::NoValue;
+}
+
+extern "C" runtime::SimpleOptional<runtime::Integer> jsonDocumentElement(Document *document, runtime::Integer entry,
+                                                                         runtime::Integer i) {
+    if (document->index().byte(entry) != '[' || i < 0) {
+        return runtime::NoValue;
+    }
+    auto element = jsonDocumentFirst(document, entry);
+    for (; i > 0 && !(element == runtime::NoValue); i--) {
+        element = jsonDocumentNext(document, *element);
+    }
+    return element;
+}
+
+extern "C" runtime::Integer jsonDocumentCount(Document *document, runtime::Integer entry) {
+    runtime::Integer count = 0;
+    for (auto child = jsonDocumentFirst(document, entry); !(child == runtime::NoValue);
+         child = jsonDocumentNext(document, *child)) {
+        count++;
+    }
+    return count;
+}
+
+extern "C" runtime::SimpleOptional<runtime::Integer> jsonDocumentInteger(Document *document, runtime::Integer entry) {
+    auto &index = document->index();
+    auto pos = document->bytes() + index.offset(entry), end = document->bytes() + index.atomEnd(entry);
+    bool negative = *pos == '-';
+    if (negative) {
+        pos++;
+    }
+    uint64_t magnitude = 0;
+    for (; pos < end; pos++) {
+        if (*pos < '0' || *pos > '9' ||
+            __builtin_mul_overflow(magnitude, 10, &magnitude) ||
+            __builtin_add_overflow(magnitude, static_cast<uint64_t>(*pos - '0'), &magnitude)) {
+            return runtime::NoValue;
+        }
+    }
+    auto limit = static_cast<uint64_t>(std::numeric_limits<runtime::Integer>::max()) + (negative ? 1 : 0);
+    if (magnitude > limit) {
+        return runtime::NoValue;
+    }
+    return negative ? static_cast<runtime::Integer>(0 - magnitude) : static_cast<runtime::Integer>(magnitude);
+}
+
+extern "C" runtime::Real jsonDocumentReal(Document *document, runtime::Integer entry) {
+    auto &index = document->index();
+    auto bytes = reinterpret_cast<const char *>(document->bytes());
+    runtime::Real real = 0;
+    // Every number the index accepted matches the grammar of parseReal().
+    s::numbers::parseReal(bytes + index.offset(entry), bytes + index.atomEnd(entry), &real);
+    return real;
+}
+
+}  // namespace json
@@ -0,0 +1,360 @@
+#include "Structural.h"
+#include <cctype>
+#include <cstring>
+#include <limits>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __PCLMUL__
+#include <wmmintrin.h>
+#endif
+
+namespace json {
+
+namespace {
+
+/// Bit masks of the classes of 64 consecutive bytes. Bit i describes the i-th byte.
+struct Block {
+    uint64_t backslash = 0;
+    uint64_t quote = 0;
+    /// The structural characters `{}[]:,`.
+    uint64_t op = 0;
+    uint64_t whitespace = 0;
+    /// The bytes below 0x20, which must not occur unescaped in strings.
+    uint64_t control = 0;
+};
+
+#ifdef __SSE2__
+inline uint64_t bits(__m128i matches, size_t chunk) {
+    return static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(matches))) << (chunk * 16);
+}
+
+Block classify(const uint8_t *bytes) {
+    Block block;
+    for (size_t chunk = 0; chunk < 4; chunk++) {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + chunk * 16));
+        // Setting bit 5 maps `[` to `{` and `]` to `}` and no other byte to either of them.
+        auto folded = _mm_or_si128(v, _mm_set1_epi8(0x20));
+        auto op = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, _mm_set1_epi8('{')),
+                                            _mm_cmpeq_epi8(folded, _mm_set1_epi8('}'))),
+                               _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')),
+                                            _mm_cmpeq_epi8(v, _mm_set1_epi8(','))));
+        auto whitespace = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                                                    _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+                                       _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')),
+                                                    _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+        auto control = _mm_cmpeq_epi8(_mm_max_epu8(v, _mm_set1_epi8(0x1F)), _mm_set1_epi8(0x1F));
+        block.backslash |= bits(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\')), chunk);
+        block.quote |= bits(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')), chunk);
+        block.op |= bits(op, chunk);
+        block.whitespace |= bits(whitespace, chunk);
+        block.control |= bits(control, chunk);
+    }
+    return block;
+}
+#else
+Block classify(const uint8_t *bytes) {
+    Block block;
+    for (size_t i = 0; i < 64; i++) {
+        auto bit = uint64_t(1) << i;
+        switch (bytes[i]) {
+            case '\\': block.backslash |= bit; break;
+            case '"': block.quote |= bit; break;
+            case '{': case '}': case '[': case ']': case ':': case ',': block.op |= bit; break;
+            case ' ': block.whitespace |= bit; break;
+            case '\t': case '\n': case '\r': block.whitespace |= bit; block.control |= bit; break;
+            default:
+                if (bytes[i] < 0x20) block.control |= bit;
+        }
+    }
+    return block;
+}
+#endif
+
+/// @returns A mask in which every bit is the XOR of all bits up to and including the same position in `x`.
+inline uint64_t prefixXor(uint64_t x) {
+#ifdef __PCLMUL__
+    auto product = _mm_clmulepi64_si128(_mm_set_epi64x(0, static_cast<int64_t>(x)), _mm_set1_epi8(-1), 0);
+    return static_cast<uint64_t>(_mm_cvtsi128_si64(product));
+#else
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+#endif
+}
+
+inline bool isSeparator(uint8_t byte) {
+    switch (byte) {
+        case '{': case '}': case '[': case ']': case ':': case ',': case '"':
+        case ' ': case '\t': case '\n': case '\r':
+            return true;
+        default:
+            return false;
+    }
+}
+
+inline bool isDigit(uint8_t byte) {
+    return '0' <= byte && byte <= '9';
+}
+
+/// @returns True if [begin, end) is a number as defined by RFC 8259.
+bool isNumber(const uint8_t *begin, const uint8_t *end) {
+    auto pos = begin;
+    if (pos < end && *pos == '-') {
+        pos++;
+    }
+    if (pos == end || !isDigit(*pos)) {
+        return false;
+    }
+    if (*pos++ != '0') {
+        while (pos < end && isDigit(*pos)) pos++;
+    }
+    if (pos < end && *pos == '.') {
+        if (++pos == end || !isDigit(*pos)) {
+            return false;
+        }
+        while (pos < end && isDigit(*pos)) pos++;
+    }
+    if (pos < end && (*pos == 'e' || *pos == 'E')) {
+        pos++;
+        if (pos < end && (*pos == '+' || *pos == '-')) {
+            pos++;
+        }
+        if (pos == end || !isDigit(*pos)) {
+            return false;
+        }
+        while (pos < end && isDigit(*pos)) pos++;
+    }
+    return pos == end;
+}
+
+}  // namespace
+
+bool StructuralIndex::build(const uint8_t *bytes, size_t count) {
+    bytes_ = bytes;
+    count_ = count;
+    offsets_.clear();
+    after_.clear();
+    if (count > std::numeric_limits<uint32_t>::max()) {
+        return fail("The document is too large.", 0);
+    }
+    return findStructurals() && link();
+}
+
+bool StructuralIndex::fail(const char *error, size_t offset) {
+    error_ = error;
+    errorOffset_ = offset;
+    return false;
+}
+
+bool StructuralIndex::findStructurals() {
+    // The state carried from one block to the next: Whether the first byte is escaped, whether it is inside a string
+    // (all bits set if so) and whether the last byte belonged to a scalar other than a string.
+    bool escapedCarry = false;
+    uint64_t stringCarry = 0;
+    uint64_t atomCarry = 0;
+    uint8_t tail[64];
+
+    for (size_t base = 0; base < count_; base += 64) {
+        auto bytes = bytes_ + base;
+        if (count_ - base < 64) {
+            // Spaces do not change the meaning of the text and are not indexed.
+            std::memset(tail, ' ', sizeof(tail));
+            std::memcpy(tail, bytes, count_ - base);
+            bytes = tail;
+        }
+        auto block = classify(bytes);
+
+        // Backslashes are rare, so the escaped bytes are simply found one backslash after the other. A backslash
+        // that is itself escaped does not escape the next byte.
+        uint64_t escaped = escapedCarry ? 1 : 0;
+        uint64_t backslashes = block.backslash & ~escaped;
+        escapedCarry = false;
+        while (backslashes != 0) {
+            auto backslash = backslashes & (~backslashes + 1);
+            auto position = base + __builtin_ctzll(backslashes);
+            if (!isEscapeSequence(position)) {
+                return fail("Invalid escape sequence.", position);
+            }
+            if (backslash == uint64_t(1) << 63) {
+                escapedCarry = true;
+            }
+            escaped |= backslash << 1;
+            backslashes &= ~(backslash | backslash << 1);
+        }
+
+        auto quotes = block.quote & ~escaped;
+        // Set for opening quotes and the contents of strings but not for closing quotes.
+        auto inString = prefixXor(quotes) ^ stringCarry;
+        stringCarry = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+        if ((block.control & inString) != 0) {
+            return fail("Unescaped control character in string.", base + __builtin_ctzll(block.control & inString));
+        }
+
+        auto atom = ~(block.op | block.whitespace | quotes | inString);
+        auto atomStart = atom & ~(atom << 1 | atomCarry);
+        atomCarry = atom >> 63;
+
+        auto structurals = (block.op & ~inString) | (quotes & inString) | atomStart;
+        while (structurals != 0) {
+            offsets_.push_back(static_cast<uint32_t>(base + __builtin_ctzll(structurals)));
+            structurals &= structurals - 1;
+        }
+    }
+
+    if (stringCarry != 0) {
+        return fail("Unterminated string.", count_);
+    }
+    return true;
+}
+
+bool StructuralIndex::link() {
+    enum class Expect { Value, ValueOrClose, Key, KeyOrClose, Colon, CommaOrClose, End };
+
+    if (offsets_.empty()) {
+        return fail("Unexpected end of input.", count_);
+    }
+    after_.resize(offsets_.size());
+    std::vector<uint32_t> open;
+    auto expect = Expect::Value;
+
+    for (size_t entry = 0; entry < offsets_.size(); entry++) {
+        auto c = byte(entry);
+        bool closes = false;
+        switch (expect) {
+            case Expect::End:
+                return fail("Unexpected input after end of value.", offset(entry));
+            case Expect::Colon:
+                if (c != ':') {
+                    return fail("Expected :.", offset(entry));
+                }
+                expect = Expect::Value;
+                continue;
+            case Expect::CommaOrClose: {
+                auto isObject = byte(open.back()) == '{';
+                if (c == ',') {
+                    expect = isObject ? Expect::Key : Expect::Value;
+                    continue;
+                }
+                if (c != (isObject ? '}' : ']')) {
+                    return fail(isObject ? "Expected }." : "Expected ].", offset(entry));
+                }
+                closes = true;
+                break;
+            }
+            case Expect::KeyOrClose:
+            case Expect::Key:
+                if (expect == Expect::KeyOrClose && c == '}') {
+                    closes = true;
+                    break;
+                }
+                if (c != '"') {
+                    return fail("Expected string.", offset(entry));
+                }
+                after_[entry] = static_cast<uint32_t>(entry + 1);
+                expect = Expect::Colon;
+                continue;
+            case Expect::ValueOrClose:
+            case Expect::Value:
+                if (expect == Expect::ValueOrClose && c == ']') {
+                    closes = true;
+                    break;
+                }
+                switch (c) {
+                    case '{':
+                        open.push_back(static_cast<uint32_t>(entry));
+                        expect = Expect::KeyOrClose;
+                        continue;
+                    case '[':
+                        open.push_back(static_cast<uint32_t>(entry));
+                        expect = Expect::ValueOrClose;
+                        continue;
+                    case '"':
+                        break;
+                    case '}': case ']': case ':': case ',':
+                        return fail("Expected value.", offset(entry));
+                    default: {
+                        auto begin = bytes_ + offset(entry), end = bytes_ + atomEnd(entry);
+                        auto length = static_cast<size_t>(end - begin);
+                        bool valid;
+                        switch (c) {
+                            case 't': valid = length == 4 && std::memcmp(begin, "true", 4) == 0; break;
+                            case 'f': valid = length == 5 && std::memcmp(begin, "false", 5) == 0; break;
+                            case 'n': valid = length == 4 && std::memcmp(begin, "null", 4) == 0; break;
+                            default: valid = isNumber(begin, end);
+                        }
+                        if (!valid) {
+                            return fail("Invalid value.", offset(entry));
+                        }
+                    }
+                }
+                after_[entry] = static_cast<uint32_t>(entry + 1);
+                break;
+        }
+
+        if (closes) {
+            after_[open.back()] = static_cast<uint32_t>(entry + 1);
+            open.pop_back();
+        }
+        expect = open.empty() ? Expect::End : Expect::CommaOrClose;
+    }
+
+    if (expect != Expect::End) {
+        return fail("Unexpected end of input.", count_);
+    }
+    return true;
+}
+
+bool StructuralIndex::isEscapeSequence(size_t backslash) const {
+    if (backslash + 1 >= count_) {
+        return false;
+    }
+    switch (bytes_[backslash + 1]) {
+        case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+            return true;
+        case 'u':
+            if (count_ - backslash < 6) {
+                return false;
+            }
+            for (size_t i = backslash + 2; i < backslash + 6; i++) {
+                if (!std::isxdigit(bytes_[i])) {
+                    return false;
+                }
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+size_t StructuralIndex::atomEnd(size_t entry) const {
+    auto pos = offset(entry);
+    while (pos < count_ && !isSeparator(bytes_[pos])) {
+        pos++;
+    }
+    return pos;
+}
+
+size_t StructuralIndex::stringEnd(size_t entry) const {
+    auto pos = offset(entry) + 1;
+    while (true) {
+        auto quote = static_cast<const uint8_t *>(std::memchr(bytes_ + pos, '"', count_ - pos)) - bytes_;
+        // The quote is escaped if it is preceded by an odd number of backslashes. The opening quote ends the run.
+        size_t backslashes = 0;
+        while (bytes_[quote - 1 - backslashes] == '\\') {
+            backslashes++;
+        }
+        if (backslashes % 2 == 0) {
+            return quote;
+        }
+        pos = quote + 1;
+    }
+}
+
+}  // namespace json
@@ -0,0 +1,58 @@
+#ifndef EMOJICODE_JSON_STRUCTURAL_H
+#define EMOJICODE_JSON_STRUCTURAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace json {
+
+/// The structural index of a JSON text.
+///
+/// The index is built in two stages. The first stage finds the offsets of all structural characters `{}[]:,`, of all
+/// opening quotes and of the first byte of every other scalar. It classifies 64 bytes at a time, with SSE2 where
+/// available, and uses bit operations to tell which bytes are inside strings. The second stage walks the entries,
+/// validates the grammar and links every value to the entry that follows it, so that values can be skipped without
+/// looking at their contents.
+class StructuralIndex {
+public:
+    /// Builds the index of the `count` bytes at `bytes`, which must stay valid as long as the index is used.
+    /// @returns False if the text is not valid JSON. error() and errorOffset() then describe the problem.
+    bool build(const uint8_t *bytes, size_t count);
+
+    const char* error() const { return error_; }
+    size_t errorOffset() const { return errorOffset_; }
+
+    /// @returns The number of entries, which are numbered from zero. Entry zero is the root value.
+    size_t size() const { return offsets_.size(); }
+    /// @returns The byte offset of `entry`.
+    size_t offset(size_t entry) const { return offsets_[entry]; }
+    /// @returns The byte at which `entry` begins.
+    uint8_t byte(size_t entry) const { return bytes_[offsets_[entry]]; }
+    /// @returns The entry after the value that begins at `entry`. For containers, this is the entry after the closing
+    /// bracket. The result is size() for the root value.
+    size_t after(size_t entry) const { return after_[entry]; }
+
+    /// @returns The offset after the last byte of the scalar other than a string that begins at `entry`.
+    size_t atomEnd(size_t entry) const;
+    /// @returns The offset of the closing quote of the string that begins at `entry`.
+    size_t stringEnd(size_t entry) const;
+
+private:
+    const uint8_t *bytes_ = nullptr;
+    size_t count_ = 0;
+    std::vector<uint32_t> offsets_;
+    std::vector<uint32_t> after_;
+    const char *error_ = nullptr;
+    size_t errorOffset_ = 0;
+
+    bool fail(const char *error, size_t offset);
+    /// @returns True if the backslash at offset `backslash` begins a valid escape sequence.
+    bool isEscapeSequence(size_t backslash) const;
+    bool findStructurals();
+    bool link();
+};
+
+}  // namespace json
+
+#endif //EMOJICODE_JSON_STRUCTURAL_H
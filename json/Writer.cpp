@@ -0,0 +1,107 @@
+#include "../runtime/Runtime.h"
+#include "../s/Numbers.h"
+#include "../s/String.h"
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using s::String;
+
+namespace json {
+
+/// @returns The number of bytes at the beginning of [begin, end) that can be written to a JSON string as they are,
+/// i.e. that are neither control characters nor `"` nor `\`.
+static size_t plainPrefix(const uint8_t *begin, const uint8_t *end) {
+    auto pos = begin;
+#ifdef __SSE2__
+    while (end - pos >= 16) {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+        auto special = _mm_or_si128(_mm_cmpeq_epi8(_mm_max_epu8(v, _mm_set1_epi8(0x1F)), _mm_set1_epi8(0x1F)),
+                                    _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')),
+                                                 _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+        if (mask != 0) {
+            return pos - begin + __builtin_ctz(mask);
+        }
+        pos += 16;
+    }
+#endif
+    while (pos < end && *pos >= 0x20 && *pos != '"' && *pos != '\\') {
+        pos++;
+    }
+    return pos - begin;
+}
+
+/// @returns The escape sequence for `byte`, which is not plain, if it has a short one, or nullptr if it must be
+/// written as `\u00XX`.
+static const char* shortEscape(uint8_t byte) {
+    switch (byte) {
+        case '"': return "\\\"";
+        case '\\': return "\\\\";
+        case '\b': return "\\b";
+        case '\f': return "\\f";
+        case '\n': return "\\n";
+        case '\r': return "\\r";
+        case '\t': return "\\t";
+        default: return nullptr;
+    }
+}
+
+extern "C" runtime::Integer jsonWriterStringLength(runtime::ClassInfo*, String *string) {
+    auto begin = reinterpret_cast<const uint8_t *>(string->characters.get()), end = begin + string->count;
+    runtime::Integer length = 2 + string->count;
+    for (auto pos = begin + plainPrefix(begin, end); pos < end; pos += 1 + plainPrefix(pos + 1, end)) {
+        length += shortEscape(*pos) != nullptr ? 1 : 5;
+    }
+    return length;
+}
+
+extern "C" runtime::Integer jsonWriterString(runtime::ClassInfo*, runtime::MemoryPointer<char> memory,
+                                             runtime::Integer offset, String *string) {
+    static const char kHexDigits[] = "0123456789abcdef";
+    auto begin = reinterpret_cast<const uint8_t *>(string->characters.get()), end = begin + string->count;
+    auto out = memory.get() + offset;
+    *out++ = '"';
+    auto pos = begin;
+    while (true) {
+        auto plain = plainPrefix(pos, end);
+        std::memcpy(out, pos, plain);
+        out += plain;
+        pos += plain;
+        if (pos == end) {
+            break;
+        }
+        if (auto escape = shortEscape(*pos)) {
+            *out++ = escape[0];
+            *out++ = escape[1];
+        }
+        else {
+            std::memcpy(out, "\\u00", 4);
+            out[4] = kHexDigits[*pos >> 4];
+            out[5] = kHexDigits[*pos & 0xF];
+            out += 6;
+        }
+        pos++;
+    }
+    *out++ = '"';
+    return out - (memory.get() + offset);
+}
+
+extern "C" runtime::Integer jsonWriterInteger(runtime::ClassInfo*, runtime::MemoryPointer<char> memory,
+                                              runtime::Integer offset, runtime::Integer value) {
+    return s::numbers::formatInteger(memory.get() + offset, value, 10);
+}
+
+extern "C" runtime::Integer jsonWriterReal(runtime::ClassInfo*, runtime::MemoryPointer<char> memory,
+                                           runtime::Integer offset, runtime::Real value) {
+    // JSON cannot represent not a number and infinities.
+    if (value != value || value - value != 0) {
+        std::memcpy(memory.get() + offset, "null", 4);
+        return 4;
+    }
+    return s::numbers::formatShortest(memory.get() + offset, value);
+}
+
+}  // namespace json
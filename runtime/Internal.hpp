@@ -6,6 +6,7 @@
 #define EMOJICODE_INTERNAL_HPP
 
 #include <atomic>
+#include <limits>
 
 namespace runtime {
 
@@ -16,9 +17,17 @@ extern int argc;
 extern char **argv;
 extern int seed;
 
+/// The strong count of immortal objects. Every negative strong count marks an immortal object. The sentinel lies in
+/// the middle of the negative range so that retains and releases racing with ejcMakeImmortal can never make it
+/// positive again.
+constexpr int kImmortalStrongCount = std::numeric_limits<int>::min() / 2;
+
 struct ControlBlock {
     std::atomic_int strongCount{1};
     std::atomic_int weakCount{0};
+
+    /// Immortal objects are never deallocated and retains and releases do not modify their counts.
+    bool isImmortal() const { return strongCount.load(std::memory_order_relaxed) < 0; }
 };
 
 struct Capture {
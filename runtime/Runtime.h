@@ -77,6 +77,8 @@ public:
 
     void retain();
     void release();
+    /// Exempts the memory area from reference counting. It is never deallocated.
+    void makeImmortal();
     
 private:
     explicit MemoryPointer(int8_t *pointer) : pointer_(pointer) {}
@@ -105,6 +107,9 @@ public:
 
     void retain();
     void release();
+    /// Exempts this object from reference counting. Retains and releases become no-ops and the object is never
+    /// deallocated. Use this for long-lived objects, e.g. the contents of global caches, that are shared widely.
+    void makeImmortal();
 protected:
     Object() : block_(internal::newControlBlock()), classInfo_(ClassInfoFor<Subclass>::value) {}
 private:
@@ -192,6 +197,7 @@ extern "C" void ejcRetain(runtime::Object<void> *object);
 extern "C" void ejcRelease(runtime::Object<void> *object);
 extern "C" void ejcReleaseCapture(runtime::internal::Capture *capture);
 extern "C" void ejcReleaseMemory(runtime::Object<void> *object);
+extern "C" void ejcMakeImmortal(runtime::Object<void> *object);
 
 template <typename Return, typename ...Args>
 void Callable<Return, Args...>::retain() const {
@@ -213,6 +219,11 @@ void Object<Subclass>::release() {
     ejcRelease(reinterpret_cast<runtime::Object<void> *>(this));
 }
 
+template <typename Subclass>
+void Object<Subclass>::makeImmortal() {
+    ejcMakeImmortal(reinterpret_cast<runtime::Object<void> *>(this));
+}
+
 template <typename Type>
 void MemoryPointer<Type>::retain() {
     ejcRetain(reinterpret_cast<runtime::Object<void> *>(pointer_));
@@ -223,6 +234,11 @@ void MemoryPointer<Type>::release() {
     ejcReleaseMemory(reinterpret_cast<runtime::Object<void> *>(pointer_));
 }
 
+template <typename Type>
+void MemoryPointer<Type>::makeImmortal() {
+    ejcMakeImmortal(reinterpret_cast<runtime::Object<void> *>(pointer_));
+}
+
 }  // namespace runtime
 
 #endif /* Runtime_h */
@@ -14,7 +14,8 @@
 #include <iostream>
 #include <random>
 
-runtime::internal::ControlBlock ejcIgnoreBlock;
+/// The control block shared by all objects that are emitted as constants by the compiler, e.g. string literals.
+runtime::internal::ControlBlock ejcIgnoreBlock{runtime::internal::kImmortalStrongCount};
 
 int runtime::internal::argc;
 char **runtime::internal::argv;
@@ -39,13 +40,13 @@ extern "C" void ejcRetain(runtime::Object<void> *object) {
         (*ptr)++;
         return;
     }
-    if (controlBlock == &ejcIgnoreBlock) return;
+    if (controlBlock->isImmortal()) return;
     controlBlock->strongCount.fetch_add(1, std::memory_order_relaxed);
 }
 
 extern "C" void ejcRetainMemory(runtime::Object<void> *object) {
     runtime::internal::ControlBlock *controlBlock = object->controlBlock();
-    if (controlBlock == &ejcIgnoreBlock) return;
+    if (controlBlock->isImmortal()) return;
     controlBlock->strongCount.fetch_add(1, std::memory_order_relaxed);
 }
 
@@ -67,6 +68,22 @@ void deleteControlBlock(runtime::internal::ControlBlock *block) {
     }
 }
 
+/// Deinitializes and frees an object whose strong reference count has dropped to zero. Inlined releases call this
+/// function directly after decrementing the counter themselves.
+extern "C" void ejcDeallocate(runtime::Object<void> *object) {
+    runtime::internal::ControlBlock *controlBlock = object->controlBlock();
+    object->classInfo()->destructor(object);
+    deleteControlBlock(controlBlock);
+    free(object);
+}
+
+/// Frees a memory area whose strong reference count has dropped to zero.
+/// @see ejcDeallocate
+extern "C" void ejcDeallocateMemory(runtime::Object<void> *object) {
+    delete object->controlBlock();
+    free(object);
+}
+
 extern "C" void ejcRelease(runtime::Object<void> *object) {
     runtime::internal::ControlBlock *controlBlock = object->controlBlock();
     if (controlBlock == nullptr) {
@@ -75,13 +92,17 @@ extern "C" void ejcRelease(runtime::Object<void> *object) {
         }
         return;
     }
-    if (controlBlock == &ejcIgnoreBlock) return;
+    if (controlBlock->isImmortal()) return;
 
     if (controlBlock->strongCount.fetch_sub(1, std::memory_order_acq_rel) - 1 != 0) return;
 
-    object->classInfo()->destructor(object);
-    deleteControlBlock(controlBlock);
-    free(object);
+    ejcDeallocate(object);
+}
+
+extern "C" void ejcMakeImmortal(runtime::Object<void> *object) {
+    runtime::internal::ControlBlock *controlBlock = object->controlBlock();
+    if (controlBlock == nullptr) return;  // Objects on the stack die with their frame anyway.
+    controlBlock->strongCount.store(runtime::internal::kImmortalStrongCount, std::memory_order_relaxed);
 }
 
 extern "C" void ejcReleaseCapture(runtime::internal::Capture *capture) {
@@ -103,12 +124,11 @@ extern "C" void ejcReleaseCapture(runtime::internal::Capture *capture) {
 extern "C" void ejcReleaseMemory(runtime::Object<void> *object) {
     runtime::internal::ControlBlock *controlBlock = object->controlBlock();
 
-    if (controlBlock == &ejcIgnoreBlock) return;
+    if (controlBlock->isImmortal()) return;
 
     if (controlBlock->strongCount.fetch_sub(1, std::memory_order_acq_rel) - 1 != 0) return;
 
-    delete controlBlock;
-    free(object);
+    ejcDeallocateMemory(object);
 }
 
 extern "C" void ejcReleaseWithoutDeinit(runtime::Object<void> *object) {
@@ -244,7 +264,7 @@ extern "C" bool ejcIsOnlyReference(runtime::Object<void> *object) {
     if (controlBlock == nullptr) {
         return *reinterpret_cast<int64_t *>(reinterpret_cast<uint8_t *>(object) - 8) == 1;
     }
-    if (controlBlock == &ejcIgnoreBlock) return false;  // Impossible to say as object is not reference counted
+    if (controlBlock->isImmortal()) return false;  // Impossible to say as object is not reference counted
     return controlBlock->strongCount == 1;
 }
 
@@ -0,0 +1,169 @@
+#include "ByteOperations.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace s {
+
+namespace bytes {
+
+#ifdef __SSE2__
+static inline __m128i load(const uint8_t *pointer) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(pointer));
+}
+#endif
+
+const uint8_t* find(const uint8_t *begin, const uint8_t *end, uint8_t byte) {
+    if (begin >= end) {
+        return nullptr;
+    }
+    return static_cast<const uint8_t *>(std::memchr(begin, byte, end - begin));
+}
+
+const uint8_t* find(const uint8_t *begin, const uint8_t *end, const uint8_t *needle, size_t count) {
+    if (count == 0) {
+        return begin;
+    }
+    if (begin >= end || static_cast<size_t>(end - begin) < count) {
+        return nullptr;
+    }
+    if (count == 1) {
+        return find(begin, end, needle[0]);
+    }
+
+    // Every index up to and including this one is a possible start of an occurrence.
+    size_t lastStart = (end - begin) - count;
+    size_t i = 0;
+#ifdef __SSE2__
+    // Filters 16 possible starts at once by comparing the first and the last byte of the needle. Only the candidates
+    // that pass both are compared completely.
+    auto first = _mm_set1_epi8(static_cast<char>(needle[0]));
+    auto last = _mm_set1_epi8(static_cast<char>(needle[count - 1]));
+    for (; i + 15 <= lastStart; i += 16) {
+        auto matches = _mm_and_si128(_mm_cmpeq_epi8(load(begin + i), first),
+                                     _mm_cmpeq_epi8(load(begin + i + count - 1), last));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(matches));
+        while (mask != 0) {
+            auto candidate = begin + i + __builtin_ctz(mask);
+            if (std::memcmp(candidate + 1, needle + 1, count - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+    while (i <= lastStart) {
+        auto candidate = find(begin + i, begin + lastStart + 1, needle[0]);
+        if (candidate == nullptr) {
+            return nullptr;
+        }
+        if (std::memcmp(candidate + 1, needle + 1, count - 1) == 0) {
+            return candidate;
+        }
+        i = candidate - begin + 1;
+    }
+    return nullptr;
+}
+
+size_t count(const uint8_t *begin, const uint8_t *end, uint8_t byte) {
+    if (begin >= end) {
+        return 0;
+    }
+    size_t result = 0;
+    auto pos = begin;
+#ifdef __SSE2__
+    auto target = _mm_set1_epi8(static_cast<char>(byte));
+    while (end - pos >= 16) {
+        // A match sets a lane to -1, so subtracting increments the lane’s counter. The counters are 8 bits wide and
+        // must therefore be summed up at least every 255 blocks.
+        auto blocks = std::min<size_t>((end - pos) / 16, 255);
+        auto counters = _mm_setzero_si128();
+        for (size_t i = 0; i < blocks; i++, pos += 16) {
+            counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(load(pos), target));
+        }
+        auto sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+        result += _mm_extract_epi16(sums, 0) + _mm_extract_epi16(sums, 4);
+    }
+#endif
+    return result + std::count(pos, end, byte);
+}
+
+void exclusiveOr(uint8_t *destination, const uint8_t *a, const uint8_t *b, size_t count) {
+    size_t i = 0;
+#ifdef __SSE2__
+    for (; i + 16 <= count; i += 16) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), _mm_xor_si128(load(a + i), load(b + i)));
+    }
+#endif
+    for (; i < count; i++) {
+        destination[i] = a[i] ^ b[i];
+    }
+}
+
+size_t asciiPrefix(const uint8_t *begin, const uint8_t *end) {
+    auto pos = begin;
+#ifdef __SSE2__
+    while (end - pos >= 16) {
+        // The most significant bit of every byte that is not ASCII is set.
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(load(pos)));
+        if (mask != 0) {
+            return pos - begin + __builtin_ctz(mask);
+        }
+        pos += 16;
+    }
+#endif
+    while (pos < end && *pos < 0x80) {
+        pos++;
+    }
+    return pos - begin;
+}
+
+bool isValidUTF8(const uint8_t *begin, const uint8_t *end) {
+    auto pos = begin;
+    while (pos < end) {
+        pos += asciiPrefix(pos, end);
+        if (pos == end) {
+            return true;
+        }
+
+        auto lead = *pos;
+        // The range of the first continuation byte is restricted for some leading bytes to reject overlong
+        // encodings, surrogates and code points beyond U+10FFFF.
+        uint8_t min = 0x80, max = 0xBF;
+        int continuations;
+        if (0xC2 <= lead && lead <= 0xDF) {
+            continuations = 1;
+        }
+        else if (0xE0 <= lead && lead <= 0xEF) {
+            continuations = 2;
+            if (lead == 0xE0) min = 0xA0;
+            else if (lead == 0xED) max = 0x9F;
+        }
+        else if (0xF0 <= lead && lead <= 0xF4) {
+            continuations = 3;
+            if (lead == 0xF0) min = 0x90;
+            else if (lead == 0xF4) max = 0x8F;
+        }
+        else {
+            return false;
+        }
+
+        if (end - pos <= continuations || pos[1] < min || pos[1] > max) {
+            return false;
+        }
+        for (int i = 2; i <= continuations; i++) {
+            if ((pos[i] & 0xC0) != 0x80) {
+                return false;
+            }
+        }
+        pos += continuations + 1;
+    }
+    return true;
+}
+
+}  // namespace bytes
+
+}  // namespace s
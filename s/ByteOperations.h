@@ -0,0 +1,37 @@
+#ifndef EMOJICODE_BYTEOPERATIONS_H
+#define EMOJICODE_BYTEOPERATIONS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace s {
+
+/// Bulk operations on byte sequences, which are used by 📇 and 🔡. Where available they process 16 bytes at a time
+/// with SSE2, otherwise they fall back to the C library or scalar code.
+namespace bytes {
+
+/// @returns A pointer to the first occurrence of `byte` in [begin, end) or nullptr if it does not occur.
+const uint8_t* find(const uint8_t *begin, const uint8_t *end, uint8_t byte);
+
+/// @returns A pointer to the first occurrence of the `count` bytes at `needle` in [begin, end), `begin` if `count`
+/// is zero, or nullptr if the needle does not occur.
+const uint8_t* find(const uint8_t *begin, const uint8_t *end, const uint8_t *needle, size_t count);
+
+/// @returns The number of occurrences of `byte` in [begin, end).
+size_t count(const uint8_t *begin, const uint8_t *end, uint8_t byte);
+
+/// Stores the XOR of the `count` bytes at `a` and `b` to `destination`, which may be equal to `a` or `b`.
+void exclusiveOr(uint8_t *destination, const uint8_t *a, const uint8_t *b, size_t count);
+
+/// @returns The number of bytes at the beginning of [begin, end) that are ASCII characters.
+size_t asciiPrefix(const uint8_t *begin, const uint8_t *end);
+
+/// @returns True if [begin, end) is valid UTF-8. Overlong encodings, surrogates and code points above U+10FFFF are
+/// rejected. Runs of ASCII characters are skipped 16 bytes at a time.
+bool isValidUTF8(const uint8_t *begin, const uint8_t *end);
+
+}  // namespace bytes
+
+}  // namespace s
+
+#endif //EMOJICODE_BYTEOPERATIONS_H
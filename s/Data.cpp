@@ -3,30 +3,83 @@
 //
 
 #include "../runtime/Runtime.h"
+#include "ByteOperations.h"
 #include "Data.h"
 #include "String.h"
 #include "utf8proc.h"
 #include <algorithm>
+#include <cstring>
+#include <vector>
 
 namespace s {
 
+static const uint8_t* bytesOf(Data *data) {
+    return reinterpret_cast<const uint8_t *>(data->data.get());
+}
+
 extern "C" runtime::SimpleOptional<runtime::Integer> sDataFindFromIndex(Data *data, Data *search,
                                                                         runtime::Integer offset) {
     if (offset >= data->count) {
         return runtime::NoValue;
     }
-    auto end = data->data.get() + data->count;
-    auto pos = std::search(data->data.get() + offset, end, search->data.get(), search->data.get() + search->count);
-    if (pos != end) {
-        return pos - data->data.get();
+    auto pos = bytes::find(bytesOf(data) + offset, bytesOf(data) + data->count, bytesOf(search), search->count);
+    if (pos != nullptr) {
+        return pos - bytesOf(data);
     }
     return runtime::NoValue;
 }
 
-extern "C" runtime::SimpleOptional<String *> sDataAsString(Data *data) {
-    auto chars = reinterpret_cast<char *>(data->data.get());
+extern "C" runtime::SimpleOptional<runtime::Integer> sDataFindByte(Data *data, runtime::Byte byte,
+                                                                   runtime::Integer offset) {
+    if (offset < 0 || offset >= data->count) {
+        return runtime::NoValue;
+    }
+    auto pos = bytes::find(bytesOf(data) + offset, bytesOf(data) + data->count, static_cast<uint8_t>(byte));
+    if (pos != nullptr) {
+        return pos - bytesOf(data);
+    }
+    return runtime::NoValue;
+}
+
+extern "C" runtime::Integer sDataCountByte(Data *data, runtime::Byte byte) {
+    return bytes::count(bytesOf(data), bytesOf(data) + data->count, static_cast<uint8_t>(byte));
+}
+
+extern "C" Data* sDataXor(Data *data, Data *key) {
+    auto result = Data::init();
+    result->count = data->count;
+    result->data = runtime::allocate<runtime::Byte>(data->count);
+    auto destination = reinterpret_cast<uint8_t *>(result->data.get());
 
-    // TODO: validate
+    if (key->count == 0) {
+        std::memcpy(destination, bytesOf(data), data->count);
+        return result;
+    }
+    if (key->count >= data->count) {
+        bytes::exclusiveOr(destination, bytesOf(data), bytesOf(key), data->count);
+        return result;
+    }
+
+    // Short keys are repeated into a buffer first so that the bytes are still processed in large blocks.
+    runtime::Integer blockSize = key->count;
+    while (blockSize < 256 && blockSize < data->count) {
+        blockSize += key->count;
+    }
+    std::vector<uint8_t> block(blockSize);
+    for (runtime::Integer i = 0; i < blockSize; i += key->count) {
+        std::memcpy(block.data() + i, bytesOf(key), key->count);
+    }
+    for (runtime::Integer offset = 0; offset < data->count; offset += blockSize) {
+        bytes::exclusiveOr(destination + offset, bytesOf(data) + offset, block.data(),
+                           std::min(blockSize, data->count - offset));
+    }
+    return result;
+}
+
+extern "C" runtime::SimpleOptional<String *> sDataAsString(Data *data) {
+    if (!bytes::isValidUTF8(bytesOf(data), bytesOf(data) + data->count)) {
+        return runtime::NoValue;
+    }
 
     auto *string = String::init();
     string->count = data->count;
@@ -0,0 +1,120 @@
+#include "Graphemes.h"
+#include "utf8proc.h"
+
+namespace s {
+
+GraphemeWalker::GraphemeWalker(const String *string, GraphemeCheckpoint checkpoint)
+        : bytes_(reinterpret_cast<const uint8_t *>(string->characters.get())), count_(string->count),
+          begin_(checkpoint.offset), state_(checkpoint.state) {
+    if (begin_ < count_) {
+        position_ = begin_ + decode(begin_, &previous_);
+    }
+}
+
+size_t GraphemeWalker::decode(size_t offset, int32_t *codepoint) const {
+    auto length = utf8proc_iterate(bytes_ + offset, count_ - offset, codepoint);
+    if (length < 1) {
+        *codepoint = 0xFFFD;
+        return 1;
+    }
+    return length;
+}
+
+void GraphemeWalker::next() {
+    while (position_ < count_) {
+        int32_t codepoint;
+        auto length = decode(position_, &codepoint);
+        auto isBreak = utf8proc_grapheme_break_stateful(previous_, codepoint, &state_);
+        previous_ = codepoint;
+        if (isBreak) {
+            begin_ = position_;
+            position_ += length;
+            return;
+        }
+        position_ += length;
+    }
+    begin_ = count_;
+}
+
+void GraphemeWalker::advance(size_t n) {
+    for (; n > 0 && !atEnd(); n--) {
+        next();
+    }
+}
+
+GraphemeIndex::GraphemeIndex(const String *string) {
+    GraphemeWalker walker(string);
+    for (; !walker.atEnd(); walker.next(), count_++) {
+        if (count_ % kStride == 0) {
+            checkpoints_.emplace_back(walker.checkpoint());
+        }
+    }
+}
+
+GraphemeIndex* GraphemeIndex::of(String *string) {
+    auto index = __atomic_load_n(&string->graphemeIndex, __ATOMIC_ACQUIRE);
+    if (index != nullptr) {
+        return index;
+    }
+    // Strings are immutable and may be shared between threads. If another thread stored an index in the meantime,
+    // that index is used and the one built here is discarded.
+    auto built = GraphemeIndex::init(string);
+    if (__atomic_compare_exchange_n(&string->graphemeIndex, &index, built, false, __ATOMIC_ACQ_REL,
+                                    __ATOMIC_ACQUIRE)) {
+        return built;
+    }
+    built->release();
+    return index;
+}
+
+GraphemeWalker GraphemeIndex::walkerAt(const String *string, size_t grapheme) const {
+    if (grapheme >= count_) {
+        return GraphemeWalker(string, {static_cast<size_t>(string->count), 0});
+    }
+    GraphemeWalker walker(string, checkpoints_[grapheme / kStride]);
+    walker.advance(grapheme % kStride);
+    return walker;
+}
+
+/// Iterator over the offsets at which the graphemes of a string begin, represented by 🍢.
+class GraphemeIterator : public runtime::Object<GraphemeIterator> {
+public:
+    explicit GraphemeIterator(String *string) : string_(string), walker_(string) {
+        string_->retain();
+    }
+    ~GraphemeIterator() {
+        string_->release();
+    }
+
+    GraphemeWalker& walker() { return walker_; }
+
+private:
+    String *string_;
+    GraphemeWalker walker_;
+};
+
+extern "C" void sGraphemeIndexDestruct(GraphemeIndex *index) {
+    index->~GraphemeIndex();
+}
+
+extern "C" GraphemeIterator* sGraphemeIteratorNew(String *string) {
+    return GraphemeIterator::init(string);
+}
+
+extern "C" runtime::Integer sGraphemeIteratorNext(GraphemeIterator *iterator) {
+    auto offset = iterator->walker().offset();
+    iterator->walker().next();
+    return offset;
+}
+
+extern "C" char sGraphemeIteratorHasNext(GraphemeIterator *iterator) {
+    return !iterator->walker().atEnd();
+}
+
+extern "C" void sGraphemeIteratorDestruct(GraphemeIterator *iterator) {
+    iterator->~GraphemeIterator();
+}
+
+}  // namespace s
+
+SET_INFO_FOR(s::GraphemeIterator, s, 1f362)
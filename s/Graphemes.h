@@ -0,0 +1,81 @@
+#ifndef EMOJICODE_GRAPHEMES_H
+#define EMOJICODE_GRAPHEMES_H
+
+#include "../runtime/Runtime.h"
+#include "String.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace s {
+
+/// The position of a grapheme boundary together with the state of the grapheme break algorithm at that boundary.
+struct GraphemeCheckpoint {
+    size_t offset;
+    int32_t state;
+};
+
+/// Walks over the graphemes of a string without allocating any memory.
+class GraphemeWalker {
+public:
+    /// Creates a walker positioned at the first grapheme of `string`.
+    explicit GraphemeWalker(const String *string) : GraphemeWalker(string, {0, 0}) {}
+    /// Creates a walker positioned at a checkpoint that was previously obtained from checkpoint().
+    GraphemeWalker(const String *string, GraphemeCheckpoint checkpoint);
+
+    /// @returns True if the walker has been advanced past the last grapheme.
+    bool atEnd() const { return begin_ >= count_; }
+    /// @returns The byte offset at which the current grapheme begins or the length of the string if atEnd().
+    size_t offset() const { return begin_; }
+    /// @returns A checkpoint from which a walker can resume at the current grapheme.
+    GraphemeCheckpoint checkpoint() const { return {begin_, state_}; }
+
+    /// Advances the walker to the next grapheme.
+    void next();
+    /// Advances the walker by `n` graphemes or until atEnd().
+    void advance(size_t n);
+
+private:
+    const uint8_t *bytes_;
+    size_t count_;
+    /// The offset at which the current grapheme begins.
+    size_t begin_;
+    /// The offset of the first code point that was not yet passed to the break algorithm.
+    size_t position_ = 0;
+    int32_t previous_ = 0;
+    int32_t state_;
+
+    /// Decodes the code point at `offset`. Invalid UTF-8 is decoded as one U+FFFD per byte.
+    /// @returns The number of bytes the code point occupies.
+    size_t decode(size_t offset, int32_t *codepoint) const;
+};
+
+/// A sparse index of the grapheme boundaries of a string, which records a checkpoint for every kStride-th grapheme.
+///
+/// The index is built the first time graphemes of a string are accessed by index and is kept by the string until it
+/// is deallocated. Locating a grapheme afterwards only requires walking over less than kStride graphemes.
+class GraphemeIndex : public runtime::Object<GraphemeIndex> {
+public:
+    static constexpr size_t kStride = 64;
+
+    explicit GraphemeIndex(const String *string);
+
+    /// @returns The index of `string`, which is built if the string does not have an index yet.
+    static GraphemeIndex* of(String *string);
+
+    /// @returns The number of graphemes in the string.
+    size_t count() const { return count_; }
+    /// @returns A walker positioned at the grapheme with index `grapheme` in `string`, which must be the string for
+    /// which this index was built, or a walker at the end if there is no such grapheme.
+    GraphemeWalker walkerAt(const String *string, size_t grapheme) const;
+
+private:
+    std::vector<GraphemeCheckpoint> checkpoints_;
+    size_t count_ = 0;
+};
+
+}  // namespace s
+
+SET_INFO_FOR(s::GraphemeIndex, s, 1f4d1)
+
+#endif //EMOJICODE_GRAPHEMES_H
@@ -7,10 +7,12 @@
 //
 
 #include "../runtime/Runtime.h"
+#include "Numbers.h"
 #include "String.h"
 #include <cstdint>
 #include <cstdlib>
-#include <cmath>
+#include <cstring>
+#include <string>
 
 using s::String;
 
@@ -18,67 +20,41 @@ extern "C" runtime::Integer sIntAbsolute(runtime::Integer *integer) {
     return std::abs(*integer);
 }
 
-extern "C" s::String* sIntToString(runtime::Integer *nptr, runtime::Integer base) {
-    auto n = *nptr;
-    auto a = std::abs(n);
-    bool negative = n < 0;
-
-    unsigned int d = negative ? 2 : 1;
-    while ((n /= base) != 0) {
-        d++;
-    }
-
+/// Creates a string from the `length` characters in `buffer`.
+static String* stringFromBuffer(const char *buffer, size_t length) {
     auto string = String::init();
-    string->count = d;
-    string->characters = runtime::allocate<char>(d);
-
-    auto *characters = string->characters.get() + d;
-    do {
-        *--characters =  "0123456789abcdefghijklmnopqrstuvxyz"[a % base % 35];
-    } while ((a /= base) > 0);
-
-    if (negative) {
-        characters[-1] = '-';
-    }
+    string->count = length;
+    string->characters = runtime::allocate<char>(length);
+    std::memcpy(string->characters.get(), buffer, length);
     return string;
 }
 
-extern "C" s::String* sRealToString(runtime::Real *real, runtime::Integer precision) {
-    double integral;
-    double fractional = std::modf(*real, &integral);
-
-    if (precision <= 0) {
-        runtime::Integer i = static_cast<runtime::Integer>(integral);
-        return sIntToString(&i, 10);
-    }
-
-    auto a = std::abs(static_cast<long long>(integral));
-    bool negative = *real < 0;
+extern "C" s::String* sIntToString(runtime::Integer *n, runtime::Integer base) {
+    char buffer[s::numbers::kMaxIntegerLength];
+    return stringFromBuffer(buffer, s::numbers::formatInteger(buffer, *n, base));
+}
 
-    unsigned int d = (negative ? 3 : 2) + precision;
-    auto ac = a;
-    while ((ac /= 10) != 0) {
-        d++;
+extern "C" s::String* sRealToString(runtime::Real *real, runtime::Integer precision) {
+    auto length = s::numbers::formatRealLength(*real, precision);
+    if (length <= 512) {
+        char buffer[512];
+        return stringFromBuffer(buffer, s::numbers::formatReal(buffer, *real, precision));
     }
+    std::string buffer(length, '\0');
+    return stringFromBuffer(&buffer[0], s::numbers::formatReal(&buffer[0], *real, precision));
+}
 
-    auto string = String::init();
-    string->count = d;
-    string->characters = runtime::allocate<char>(d);
-
-    auto *characters = string->characters.get() + d;
+extern "C" s::String* sRealToShortestString(runtime::Real *real) {
+    char buffer[s::numbers::kMaxShortestLength];
+    return stringFromBuffer(buffer, s::numbers::formatShortest(buffer, *real));
+}
 
-    auto f = static_cast<long long>(std::abs(std::pow(10, precision) * fractional));
-    for (decltype(precision) i = 0; i < precision; i++) {
-        *--characters = "0123456789"[f % 10];
-        f /= 10;
-    }
-    *--characters = '.';
-    do {
-        *--characters = "0123456789"[a % 10];
-    } while ((a /= 10) > 0);
-    if (negative) {
-        characters[-1] = '-';
+extern "C" runtime::SimpleOptional<runtime::Real> sRealParse(runtime::MemoryPointer<char> memory,
+                                                             runtime::Integer offset, runtime::Integer length) {
+    auto begin = memory.get() + offset;
+    runtime::Real real;
+    if (!s::numbers::parseReal(begin, begin + length, &real)) {
+        return runtime::NoValue;
     }
-    return string;
+    return real;
 }
-
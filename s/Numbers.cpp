@@ -0,0 +1,453 @@
+#include "Numbers.h"
+#include "NumberTables.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace s {
+
+namespace numbers {
+
+static const char kDigitPairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+/// Writes the decimal digits of `value` so that they end at `end`.
+/// @returns A pointer to the first digit.
+static char* writeDecimalDigits(char *end, uint64_t value) {
+    while (value >= 100) {
+        end -= 2;
+        std::memcpy(end, kDigitPairs + (value % 100) * 2, 2);
+        value /= 100;
+    }
+    if (value >= 10) {
+        end -= 2;
+        std::memcpy(end, kDigitPairs + value * 2, 2);
+    }
+    else {
+        *--end = static_cast<char>('0' + value);
+    }
+    return end;
+}
+
+size_t formatInteger(char *buffer, int64_t value, int64_t base) {
+    // The magnitude is computed with unsigned arithmetic as the magnitude of the smallest value cannot be represented
+    // as int64_t.
+    uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    char digits[64];
+    auto end = digits + sizeof(digits);
+    auto begin = end;
+    if (base == 10) {
+        begin = writeDecimalDigits(end, magnitude);
+    }
+    else {
+        do {
+            *--begin = "0123456789abcdefghijklmnopqrstuvwxyz"[magnitude % base];
+        } while ((magnitude /= base) > 0);
+    }
+
+    size_t length = 0;
+    if (value < 0) {
+        buffer[length++] = '-';
+    }
+    std::memcpy(buffer + length, begin, end - begin);
+    return length + (end - begin);
+}
+
+// The following is an implementation of Ryū, see Ulf Adams. 2018. Ryū: fast float-to-string conversion.
+// https://doi.org/10.1145/3192366.3192369
+
+constexpr int kMantissaBits = 52;
+constexpr int kExponentBits = 11;
+constexpr int kBias = 1023;
+constexpr int kPow5InverseBitCount = 125;
+constexpr int kPow5BitCount = 125;
+
+/// @returns ceil(log2(5^e)) for 0 < e <= 3528 and 1 for e = 0.
+static inline int32_t pow5Bits(int32_t e) {
+    return static_cast<int32_t>((static_cast<uint32_t>(e) * 1217359) >> 19) + 1;
+}
+
+/// @returns floor(log10(2^e)) for 0 <= e <= 1650.
+static inline uint32_t log10Pow2(int32_t e) {
+    return (static_cast<uint32_t>(e) * 78913) >> 18;
+}
+
+/// @returns floor(log10(5^e)) for 0 <= e <= 2620.
+static inline uint32_t log10Pow5(int32_t e) {
+    return (static_cast<uint32_t>(e) * 732923) >> 20;
+}
+
+static inline bool isMultipleOfPowerOf5(uint64_t value, uint32_t p) {
+    uint32_t count = 0;
+    while (value % 5 == 0 && count < p) {
+        value /= 5;
+        count++;
+    }
+    return count >= p;
+}
+
+static inline bool isMultipleOfPowerOf2(uint64_t value, uint32_t p) {
+    return (value & ((1ull << p) - 1)) == 0;
+}
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 uint128;
+
+static inline uint64_t mulShift(uint64_t m, const uint64_t *multiplier, int32_t shift) {
+    auto low = static_cast<uint128>(m) * multiplier[0];
+    auto high = static_cast<uint128>(m) * multiplier[1];
+    return static_cast<uint64_t>(((low >> 64) + high) >> (shift - 64));
+}
+#else
+/// Multiplies `a` and `b` and stores the upper 64 bits of the product in `high`.
+static inline uint64_t multiply128(uint64_t a, uint64_t b, uint64_t *high) {
+    auto aLow = a & 0xFFFFFFFF, aHigh = a >> 32, bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+    auto lowLow = aLow * bLow, lowHigh = aLow * bHigh, highLow = aHigh * bLow, highHigh = aHigh * bHigh;
+    auto middle = (lowLow >> 32) + (lowHigh & 0xFFFFFFFF) + (highLow & 0xFFFFFFFF);
+    *high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+    return (middle << 32) | (lowLow & 0xFFFFFFFF);
+}
+
+/// Shifts the 128-bit value `high`:`low` right by `shift` bits, which must be between 1 and 63.
+static inline uint64_t shiftRight128(uint64_t low, uint64_t high, int32_t shift) {
+    return (high << (64 - shift)) | (low >> shift);
+}
+
+static inline uint64_t mulShift(uint64_t m, const uint64_t *multiplier, int32_t shift) {
+    uint64_t high0, high1;
+    multiply128(m, multiplier[0], &high0);
+    auto low1 = multiply128(m, multiplier[1], &high1);
+    auto sum = high0 + low1;
+    high1 += sum < high0;
+    return shiftRight128(sum, high1, shift - 64);
+}
+#endif
+
+Decimal shortest(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    auto ieeeMantissa = bits & ((1ull << kMantissaBits) - 1);
+    auto ieeeExponent = static_cast<uint32_t>((bits >> kMantissaBits) & ((1u << kExponentBits) - 1));
+
+    // The value is m2 × 2^e2. The exponent is reduced by two so that the halfway points to the neighbouring values,
+    // which bound the interval of decimals that are parsed to the value, are integers as well.
+    int32_t e2;
+    uint64_t m2;
+    if (ieeeExponent == 0) {
+        e2 = 1 - kBias - kMantissaBits - 2;
+        m2 = ieeeMantissa;
+    }
+    else {
+        e2 = static_cast<int32_t>(ieeeExponent) - kBias - kMantissaBits - 2;
+        m2 = (1ull << kMantissaBits) | ieeeMantissa;
+    }
+    bool acceptBounds = (m2 & 1) == 0;
+
+    // The interval is [mv - mmShift - 1, mv + 2] × 2^e2. It is asymmetric if the value is a power of two.
+    uint64_t mv = 4 * m2;
+    uint32_t mmShift = ieeeMantissa != 0 || ieeeExponent <= 1;
+
+    // Converts the interval to decimal: vr, vp and vm × 10^e10.
+    uint64_t vr, vp, vm;
+    int32_t e10;
+    bool vmIsTrailingZeros = false, vrIsTrailingZeros = false;
+    if (e2 >= 0) {
+        uint32_t q = log10Pow2(e2) - (e2 > 3);
+        e10 = static_cast<int32_t>(q);
+        int32_t k = kPow5InverseBitCount + pow5Bits(static_cast<int32_t>(q)) - 1;
+        int32_t i = -e2 + static_cast<int32_t>(q) + k;
+        vr = mulShift(4 * m2, kPow5InverseSplit[q], i);
+        vp = mulShift(4 * m2 + 2, kPow5InverseSplit[q], i);
+        vm = mulShift(4 * m2 - 1 - mmShift, kPow5InverseSplit[q], i);
+        if (q <= 21) {
+            // Only one of mp, mv, and mm can be a multiple of 5, if any.
+            if (mv % 5 == 0) {
+                vrIsTrailingZeros = isMultipleOfPowerOf5(mv, q);
+            }
+            else if (acceptBounds) {
+                vmIsTrailingZeros = isMultipleOfPowerOf5(mv - 1 - mmShift, q);
+            }
+            else {
+                vp -= isMultipleOfPowerOf5(mv + 2, q);
+            }
+        }
+    }
+    else {
+        uint32_t q = log10Pow5(-e2) - (-e2 > 1);
+        e10 = static_cast<int32_t>(q) + e2;
+        int32_t i = -e2 - static_cast<int32_t>(q);
+        int32_t k = pow5Bits(i) - kPow5BitCount;
+        int32_t j = static_cast<int32_t>(q) - k;
+        vr = mulShift(4 * m2, kPow5Split[i], j);
+        vp = mulShift(4 * m2 + 2, kPow5Split[i], j);
+        vm = mulShift(4 * m2 - 1 - mmShift, kPow5Split[i], j);
+        if (q <= 1) {
+            // mv has at least q trailing zeros as it is a multiple of 4.
+            vrIsTrailingZeros = true;
+            if (acceptBounds) {
+                vmIsTrailingZeros = mmShift == 1;
+            }
+            else {
+                vp--;
+            }
+        }
+        else if (q < 63) {
+            vrIsTrailingZeros = isMultipleOfPowerOf2(mv, q);
+        }
+    }
+
+    // Removes digits as long as the interval contains a shorter decimal.
+    int32_t removed = 0;
+    uint64_t output;
+    if (vmIsTrailingZeros || vrIsTrailingZeros) {
+        uint8_t lastRemovedDigit = 0;
+        while (vp / 10 > vm / 10) {
+            vmIsTrailingZeros &= vm % 10 == 0;
+            vrIsTrailingZeros &= lastRemovedDigit == 0;
+            lastRemovedDigit = static_cast<uint8_t>(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if (vmIsTrailingZeros) {
+            while (vm % 10 == 0) {
+                vrIsTrailingZeros &= lastRemovedDigit == 0;
+                lastRemovedDigit = static_cast<uint8_t>(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+        if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0) {
+            // The exact value is halfway between two decimals, so it is rounded to even.
+            lastRemovedDigit = 4;
+        }
+        output = vr + ((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5);
+    }
+    else {
+        // The common case, in which none of the bounds can be exact decimals.
+        bool roundUp = false;
+        if (vp / 100 > vm / 100) {
+            roundUp = vr % 100 >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+        while (vp / 10 > vm / 10) {
+            roundUp = vr % 10 >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        output = vr + (vr == vm || roundUp);
+    }
+    return {output, e10 + removed};
+}
+
+/// Writes NaN or an infinity.
+static size_t formatNonFinite(char *buffer, double value) {
+    const char *text = std::isnan(value) ? "NaN" : value < 0 ? "-Infinity" : "Infinity";
+    auto length = std::strlen(text);
+    std::memcpy(buffer, text, length);
+    return length;
+}
+
+/// Writes the digits of the shortest representation of `value`, which must be finite, to `digits`, which must have
+/// room for 20 characters.
+/// @returns The number of digits and, in `point`, the position of the decimal separator relative to the first digit.
+static size_t shortestDigits(double value, char *digits, int32_t *point) {
+    if (value == 0) {
+        digits[0] = '0';
+        *point = 1;
+        return 1;
+    }
+    auto decimal = shortest(std::fabs(value));
+    char buffer[20];
+    auto begin = writeDecimalDigits(buffer + sizeof(buffer), decimal.digits);
+    size_t count = buffer + sizeof(buffer) - begin;
+    std::memcpy(digits, begin, count);
+    *point = static_cast<int32_t>(count) + decimal.exponent;
+    return count;
+}
+
+size_t formatShortest(char *buffer, double value) {
+    if (!std::isfinite(value)) {
+        return formatNonFinite(buffer, value);
+    }
+
+    char digits[20];
+    int32_t point;
+    auto count = static_cast<int32_t>(shortestDigits(value, digits, &point));
+
+    auto pos = buffer;
+    if (std::signbit(value)) {
+        *pos++ = '-';
+    }
+    if (count <= point && point <= 21) {
+        std::memcpy(pos, digits, count);
+        std::memset(pos + count, '0', point - count);
+        pos += point;
+    }
+    else if (0 < point && point <= 21) {
+        std::memcpy(pos, digits, point);
+        pos[point] = '.';
+        std::memcpy(pos + point + 1, digits + point, count - point);
+        pos += count + 1;
+    }
+    else if (-6 < point && point <= 0) {
+        *pos++ = '0';
+        *pos++ = '.';
+        std::memset(pos, '0', -point);
+        pos += -point;
+        std::memcpy(pos, digits, count);
+        pos += count;
+    }
+    else {
+        *pos++ = digits[0];
+        if (count > 1) {
+            *pos++ = '.';
+            std::memcpy(pos, digits + 1, count - 1);
+            pos += count - 1;
+        }
+        *pos++ = 'e';
+        *pos++ = point > 0 ? '+' : '-';
+        pos += formatInteger(pos, std::abs(point - 1), 10);
+    }
+    return pos - buffer;
+}
+
+size_t formatRealLength(double value, int64_t precision) {
+    // Sign, up to 309 integral digits and the separator.
+    return 311 + (precision > 0 ? precision : 0);
+}
+
+size_t formatReal(char *buffer, double value, int64_t precision) {
+    if (!std::isfinite(value)) {
+        return formatNonFinite(buffer, value);
+    }
+
+    char digits[20];
+    int32_t point;
+    auto count = static_cast<int32_t>(shortestDigits(value, digits, &point));
+    auto digitAt = [&](int64_t i) { return 0 <= i && i < count ? digits[i] : '0'; };
+
+    auto pos = buffer;
+    if (value < 0 && (precision > 0 || point > 0)) {
+        *pos++ = '-';
+    }
+    if (point > 0) {
+        for (int32_t i = 0; i < point; i++) {
+            *pos++ = digitAt(i);
+        }
+    }
+    else {
+        *pos++ = '0';
+    }
+    if (precision > 0) {
+        *pos++ = '.';
+        for (int64_t i = 0; i < precision; i++) {
+            *pos++ = digitAt(point + i);
+        }
+    }
+    return pos - buffer;
+}
+
+/// Exactly representable powers of ten.
+static const double kPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+    1e20, 1e21, 1e22
+};
+
+bool parseReal(const char *begin, const char *end, double *result) {
+    auto pos = begin;
+    bool negative = false;
+    if (pos < end && (*pos == '-' || *pos == '+')) {
+        negative = *pos == '-';
+        pos++;
+    }
+
+    // Up to 19 significant digits are collected in mantissa. The value is mantissa × 10^exponent, unless digits
+    // were dropped.
+    uint64_t mantissa = 0;
+    int significantDigits = 0;
+    int64_t exponent = 0;
+    bool foundDigit = false, droppedDigits = false;
+    for (; pos < end && '0' <= *pos && *pos <= '9'; pos++) {
+        foundDigit = true;
+        if (significantDigits < 19) {
+            mantissa = mantissa * 10 + (*pos - '0');
+            significantDigits += mantissa > 0;
+        }
+        else {
+            exponent++;
+            droppedDigits |= *pos != '0';
+        }
+    }
+    if (pos < end && *pos == '.') {
+        for (pos++; pos < end && '0' <= *pos && *pos <= '9'; pos++) {
+            foundDigit = true;
+            if (significantDigits < 19) {
+                mantissa = mantissa * 10 + (*pos - '0');
+                significantDigits += mantissa > 0;
+                exponent--;
+            }
+            else {
+                droppedDigits |= *pos != '0';
+            }
+        }
+    }
+    if (!foundDigit) {
+        return false;
+    }
+    if (pos < end && (*pos == 'e' || *pos == 'E')) {
+        pos++;
+        bool negativeExponent = false;
+        if (pos < end && (*pos == '-' || *pos == '+')) {
+            negativeExponent = *pos == '-';
+            pos++;
+        }
+        if (pos == end) {
+            return false;
+        }
+        int64_t explicitExponent = 0;
+        for (; pos < end && '0' <= *pos && *pos <= '9'; pos++) {
+            // Larger exponents result in zero or infinity anyway.
+            if (explicitExponent < 100000) {
+                explicitExponent = explicitExponent * 10 + (*pos - '0');
+            }
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+    if (pos != end) {
+        return false;
+    }
+
+    // Clinger’s fast path: If the mantissa and the power of ten are exactly representable, a single multiplication
+    // or division is correctly rounded.
+    if (!droppedDigits && mantissa <= (1ull << 53) && -22 <= exponent && exponent <= 22) {
+        auto value = static_cast<double>(mantissa);
+        value = exponent < 0 ? value / kPowersOfTen[-exponent] : value * kPowersOfTen[exponent];
+        *result = negative ? -value : value;
+        return true;
+    }
+    if (mantissa == 0 && !droppedDigits) {
+        *result = negative ? -0.0 : 0.0;
+        return true;
+    }
+
+    // The text is known to be a valid number that strtod accepts in the C locale.
+    std::string text(begin, end);
+    *result = std::strtod(text.c_str(), nullptr);
+    return true;
+}
+
+}  // namespace numbers
+
+}  // namespace s
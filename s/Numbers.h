@@ -0,0 +1,56 @@
+#ifndef EMOJICODE_NUMBERS_H
+#define EMOJICODE_NUMBERS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace s {
+
+/// Conversion of 🔢 and 💯 from and to text, which is used by s and the json package.
+namespace numbers {
+
+/// The maximal number of characters formatInteger() writes.
+constexpr size_t kMaxIntegerLength = 65;
+/// The maximal number of characters formatShortest() writes.
+constexpr size_t kMaxShortestLength = 32;
+
+/// Writes the digits of `value` in `base`, which must be in the range 2 to 36, to `buffer`. The digits are
+/// `0123456789abcdefghijklmnopqrstuvwxyz`. Decimal numbers are formatted two digits at a time.
+/// @returns The number of characters written, at most kMaxIntegerLength.
+size_t formatInteger(char *buffer, int64_t value, int64_t base);
+
+/// A finite, positive real number represented as `digits` × 10^`exponent`.
+struct Decimal {
+    uint64_t digits;
+    int32_t exponent;
+};
+
+/// @returns The decimal with the fewest digits that is parsed to exactly `value` again. If several decimals have
+/// that number of digits, the one closest to `value` is returned. `value` must be finite and positive.
+/// The algorithm is Ryū by Ulf Adams.
+Decimal shortest(double value);
+
+/// Writes the shortest representation of `value` that is parsed to exactly `value` again. Numbers from 1e-6 to 1e21
+/// are written without exponent, e.g. `0.001` and `100`, all others in scientific notation, e.g. `1.5e+300`.
+/// Not a number and infinities are written as `NaN`, `Infinity` and `-Infinity`.
+/// @returns The number of characters written, at most kMaxShortestLength.
+size_t formatShortest(char *buffer, double value);
+
+/// Writes `value` with exactly `precision` digits after the decimal separator. Digits beyond the shortest
+/// representation of `value` are zeros and further digits are truncated. If `precision` is zero or less, only the
+/// integral part is written.
+/// @returns The number of characters written. The buffer must have room for formatRealLength() characters.
+size_t formatReal(char *buffer, double value, int64_t precision);
+/// @returns An upper bound of the number of characters formatReal() writes.
+size_t formatRealLength(double value, int64_t precision);
+
+/// Parses [begin, end) as a real number matching `[+-]?([0-9]+(\.[0-9]*)?|[0-9]*\.[0-9]+)([eE][+-]?[0-9]+)?`.
+/// The result is correctly rounded.
+/// @returns False if the text does not match.
+bool parseReal(const char *begin, const char *end, double *result);
+
+}  // namespace numbers
+
+}  // namespace s
+
+#endif //EMOJICODE_NUMBERS_H
@@ -0,0 +1,150 @@
+#include "PackedLists.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace s {
+
+static size_t wordCount(runtime::Integer bits) {
+    return (bits + 63) / 64;
+}
+
+/// @returns A mask of the bits of the last word of a list of `bits` bits that belong to the list.
+static uint64_t lastWordMask(runtime::Integer bits) {
+    return bits % 64 == 0 ? ~uint64_t(0) : (uint64_t(1) << (bits % 64)) - 1;
+}
+
+#ifdef __SSE2__
+static inline __m128i load(const uint64_t *pointer) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(pointer));
+}
+
+static inline void store(uint64_t *pointer, __m128i value) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(pointer), value);
+}
+#endif
+
+/// Counts the set bits of `count` words. SSE2 has no population count instruction, so the bits are summed up in
+/// parallel within every byte and the bytes are then added with _mm_sad_epu8().
+static uint64_t populationCount(const uint64_t *words, size_t count) {
+    uint64_t result = 0;
+    size_t i = 0;
+#ifdef __SSE2__
+    auto m1 = _mm_set1_epi8(0x55), m2 = _mm_set1_epi8(0x33), m4 = _mm_set1_epi8(0x0F);
+    auto sum = _mm_setzero_si128();
+    for (; i + 2 <= count; i += 2) {
+        auto v = load(words + i);
+        v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi16(v, 1), m1));
+        v = _mm_add_epi8(_mm_and_si128(v, m2), _mm_and_si128(_mm_srli_epi16(v, 2), m2));
+        v = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi16(v, 4)), m4);
+        sum = _mm_add_epi64(sum, _mm_sad_epu8(v, _mm_setzero_si128()));
+    }
+    uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), sum);
+    result = lanes[0] + lanes[1];
+#endif
+    for (; i < count; i++) {
+        result += __builtin_popcountll(words[i]);
+    }
+    return result;
+}
+
+extern "C" runtime::Integer sBitListCount(BitList *list) {
+    auto words = wordCount(list->count);
+    if (words == 0) {
+        return 0;
+    }
+    auto data = list->words.get();
+    return populationCount(data, words - 1) + __builtin_popcountll(data[words - 1] & lastWordMask(list->count));
+}
+
+extern "C" runtime::SimpleOptional<runtime::Integer> sBitListFind(BitList *list, runtime::Integer start) {
+    if (start < 0) {
+        start = 0;
+    }
+    if (start >= list->count) {
+        return runtime::NoValue;
+    }
+    auto data = list->words.get();
+    auto words = wordCount(list->count);
+    size_t i = start / 64;
+    // Bits before start in its word are cleared.
+    auto word = data[i] & (~uint64_t(0) << (start % 64));
+    while (word == 0) {
+        if (++i >= words) {
+            return runtime::NoValue;
+        }
+#ifdef __SSE2__
+        // Skips two empty words at once.
+        for (; i + 2 <= words; i += 2) {
+            auto zero = _mm_cmpeq_epi8(load(data + i), _mm_setzero_si128());
+            if (_mm_movemask_epi8(zero) != 0xFFFF) {
+                break;
+            }
+        }
+        if (i >= words) {
+            return runtime::NoValue;
+        }
+#endif
+        word = data[i];
+    }
+    auto index = static_cast<runtime::Integer>(i * 64 + __builtin_ctzll(word));
+    if (index >= list->count) {
+        return runtime::NoValue;
+    }
+    return index;
+}
+
+extern "C" void sBitListIntersect(BitList *list, BitList *other) {
+    auto data = list->words.get(), otherData = other->words.get();
+    auto words = wordCount(list->count), otherFull = static_cast<size_t>(other->count / 64);
+    auto shared = std::min(words, otherFull);
+    size_t i = 0;
+#ifdef __SSE2__
+    for (; i + 2 <= shared; i += 2) {
+        store(data + i, _mm_and_si128(load(data + i), load(otherData + i)));
+    }
+#endif
+    for (; i < shared; i++) {
+        data[i] &= otherData[i];
+    }
+    if (i < words && other->count % 64 != 0) {
+        data[i] &= otherData[i] & lastWordMask(other->count);
+        i++;
+    }
+    // The elements past the end of other are 👎.
+    if (i < words) {
+        std::memset(data + i, 0, (words - i) * sizeof(uint64_t));
+    }
+}
+
+extern "C" void sBitListUnite(BitList *list, BitList *other) {
+    auto data = list->words.get(), otherData = other->words.get();
+    auto words = wordCount(list->count), otherFull = static_cast<size_t>(other->count / 64);
+    auto shared = std::min(words, otherFull);
+    size_t i = 0;
+#ifdef __SSE2__
+    for (; i + 2 <= shared; i += 2) {
+        store(data + i, _mm_or_si128(load(data + i), load(otherData + i)));
+    }
+#endif
+    for (; i < shared; i++) {
+        data[i] |= otherData[i];
+    }
+    if (i < words && other->count % 64 != 0) {
+        data[i] |= otherData[i] & lastWordMask(other->count);
+    }
+}
+
+extern "C" runtime::Integer sInt32ListGet(Int32List *list, runtime::Integer index) {
+    return list->values[index];
+}
+
+extern "C" void sInt32ListSet(Int32List *list, runtime::Integer value, runtime::Integer index) {
+    list->values[index] = static_cast<int32_t>(value);
+}
+
+}  // namespace s
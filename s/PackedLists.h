@@ -0,0 +1,31 @@
+#ifndef EMOJICODE_PACKED_LISTS_H
+#define EMOJICODE_PACKED_LISTS_H
+
+#include "../runtime/Runtime.h"
+
+namespace s {
+
+/// 🍨🔸👌, a list of booleans packed into 64-bit words. Bit i of word j is the element at index j × 64 + i.
+/// The bits past `count` in the last word are unspecified and must be ignored.
+class BitList : public runtime::Object<BitList> {
+public:
+    runtime::MemoryPointer<uint64_t> words;
+    runtime::Integer count;
+    /// The capacity in words.
+    runtime::Integer size;
+};
+
+/// 🍨🔸🔢, a list of integers that are stored in 32 bits each.
+class Int32List : public runtime::Object<Int32List> {
+public:
+    runtime::MemoryPointer<int32_t> values;
+    runtime::Integer count;
+    runtime::Integer size;
+};
+
+}  // namespace s
+
+SET_INFO_FOR(s::BitList, s, 1f368_1f538_1f44c)
+SET_INFO_FOR(s::Int32List, s, 1f368_1f538_1f522)
+
+#endif //EMOJICODE_PACKED_LISTS_H
@@ -8,13 +8,15 @@
 
 #include "../runtime/Runtime.h"
 #include "../runtime/Internal.hpp"
+#include "ByteOperations.h"
 #include "Data.h"
+#include "Graphemes.h"
+#include "Numbers.h"
 #include "String.h"
 #include "utf8proc.h"
 #include <algorithm>
 #include <cctype>
 #include <cinttypes>
-#include <cmath>
 #include <cstring>
 #include <iostream>
 
@@ -30,6 +32,7 @@ String::String(const char *cstring) {
 
 void String::store(const char *cstring) {
     count = strlen(cstring);
+    graphemeIndex = nullptr;
     characters = runtime::allocate<char>(count);
     std::memcpy(characters.get(), cstring, count);
 }
@@ -69,14 +72,24 @@ extern "C" String* sStringToLowercase(String *string) {
     newString->count = string->count;
     newString->characters = runtime::allocate<char>(string->count);
 
+    auto count = static_cast<size_t>(string->count);
+    auto bytes = reinterpret_cast<const uint8_t *>(string->characters.get());
+    auto destination = reinterpret_cast<uint8_t *>(newString->characters.get());
     size_t doff = 0;
-    for (size_t off = 0; off < string->count;) {
+    for (size_t off = 0; off < count;) {
+        auto ascii = s::bytes::asciiPrefix(bytes + off, bytes + count);
+        for (size_t i = 0; i < ascii; i++) {
+            auto c = bytes[off + i];
+            destination[doff + i] = 'A' <= c && c <= 'Z' ? c + ('a' - 'A') : c;
+        }
+        off += ascii;
+        doff += ascii;
+        if (off == count) break;
+
         utf8proc_int32_t codepoint;
-        auto state = utf8proc_iterate(reinterpret_cast<utf8proc_uint8_t *>(string->characters.get()) + off,
-                                      string->count, &codepoint);
+        auto state = utf8proc_iterate(bytes + off, count - off, &codepoint);
         if (state < 0) break;
-        doff += utf8proc_encode_char(utf8proc_tolower(codepoint),
-                                     reinterpret_cast<utf8proc_uint8_t *>(newString->characters.get()) + doff);
+        doff += utf8proc_encode_char(utf8proc_tolower(codepoint), destination + doff);
         off += state;
     }
     return newString;
@@ -87,24 +100,37 @@ extern "C" String* sStringToUppercase(String *string) {
     newString->count = string->count;
     newString->characters = runtime::allocate<char>(string->count);
 
+    auto count = static_cast<size_t>(string->count);
+    auto bytes = reinterpret_cast<const uint8_t *>(string->characters.get());
+    auto destination = reinterpret_cast<uint8_t *>(newString->characters.get());
     size_t doff = 0;
-    for (size_t off = 0; off < string->count;) {
+    for (size_t off = 0; off < count;) {
+        auto ascii = s::bytes::asciiPrefix(bytes + off, bytes + count);
+        for (size_t i = 0; i < ascii; i++) {
+            auto c = bytes[off + i];
+            destination[doff + i] = 'a' <= c && c <= 'z' ? c - ('a' - 'A') : c;
+        }
+        off += ascii;
+        doff += ascii;
+        if (off == count) break;
+
         utf8proc_int32_t codepoint;
-        auto state = utf8proc_iterate(reinterpret_cast<utf8proc_uint8_t *>(string->characters.get()) + off,
-                                      string->count, &codepoint);
+        auto state = utf8proc_iterate(bytes + off, count - off, &codepoint);
         if (state < 0) break;
-        doff += utf8proc_encode_char(utf8proc_toupper(codepoint),
-                                     reinterpret_cast<utf8proc_uint8_t *>(newString->characters.get()) + doff);
+        doff += utf8proc_encode_char(utf8proc_toupper(codepoint), destination + doff);
         off += state;
     }
     return newString;
 }
 
+static const uint8_t* bytesOf(String *string) {
+    return reinterpret_cast<const uint8_t *>(string->characters.get());
+}
+
 extern "C" runtime::SimpleOptional<runtime::Integer> sStringFind(String *string, String* search) {
-    auto end = string->characters.get() + string->count;
-    auto pos = std::search(string->characters.get(), end, search->characters.get(), search->characters.get() + search->count);
-    if (pos != end) {
-        return pos - string->characters.get();
+    auto pos = s::bytes::find(bytesOf(string), bytesOf(string) + string->count, bytesOf(search), search->count);
+    if (pos != nullptr) {
+        return pos - bytesOf(string);
     }
     return runtime::NoValue;
 }
@@ -114,135 +140,130 @@ extern "C" runtime::SimpleOptional<runtime::Integer> sStringFindFromIndex(String
     if (offset >= string->count) {
         return runtime::NoValue;
     }
-    auto end = string->characters.get() + string->count;
-    auto pos = std::search(string->characters.get() + offset, end, search->characters.get(),
-                           search->characters.get() + search->count);
-    if (pos != end) {
-        return pos - string->characters.get();
+    auto pos = s::bytes::find(bytesOf(string) + offset, bytesOf(string) + string->count, bytesOf(search),
+                              search->count);
+    if (pos != nullptr) {
+        return pos - bytesOf(string);
     }
     return runtime::NoValue;
 }
 
+extern "C" runtime::Integer sStringCount(String *string, String* search) {
+    auto begin = bytesOf(string), end = bytesOf(string) + string->count;
+    if (search->count == 0) {
+        return 0;
+    }
+    if (search->count == 1) {
+        return s::bytes::count(begin, end, bytesOf(search)[0]);
+    }
+    runtime::Integer count = 0;
+    while (auto pos = s::bytes::find(begin, end, bytesOf(search), search->count)) {
+        count++;
+        begin = pos + search->count;
+    }
+    return count;
+}
+
 extern "C" void sStringCodepoints(String *string, runtime::Callable<void, runtime::Integer, runtime::Integer> cb) {
-    for (size_t off = 0; off < string->count;) {
+    auto count = static_cast<size_t>(string->count);
+    auto bytes = bytesOf(string);
+    for (size_t off = 0; off < count;) {
+        auto ascii = off + s::bytes::asciiPrefix(bytes + off, bytes + count);
+        for (; off < ascii; off++) {
+            cb(bytes[off], off);
+        }
+        if (off == count) break;
+
         utf8proc_int32_t codepoint;
-        auto state = utf8proc_iterate(reinterpret_cast<utf8proc_uint8_t *>(string->characters.get()) + off,
-                                      string->count, &codepoint);
+        auto state = utf8proc_iterate(bytes + off, count - off, &codepoint);
         if (state < 0) break;
         cb(codepoint, off);
         off += state;
     }
 }
 
+/// Whether the code point has the bidirectional class WS, the definition of whitespace used by sStringTrim.
+static bool isWhitespace(utf8proc_int32_t codepoint) {
+    if (codepoint < 0x80) {
+        return codepoint == ' ' || codepoint == '\f';  // The only ASCII characters in WS.
+    }
+    return utf8proc_get_property(codepoint)->bidi_class == UTF8PROC_BIDI_CLASS_WS;
+}
+
 extern "C" s::String* sStringTrim(String *string) {
+    auto count = static_cast<size_t>(string->count);
+    auto bytes = bytesOf(string);
     size_t begin = 0;
 
-    for (; begin < string->count;) {
+    for (; begin < count;) {
+        if (bytes[begin] < 0x80) {
+            if (!isWhitespace(bytes[begin])) break;
+            begin++;
+            continue;
+        }
         utf8proc_int32_t codepoint;
-        auto state = utf8proc_iterate(reinterpret_cast<utf8proc_uint8_t *>(string->characters.get()) + begin,
-                                      string->count, &codepoint);
-        if (state < 0) break;
-        if (utf8proc_get_property(codepoint)->bidi_class != UTF8PROC_BIDI_CLASS_WS) break;
+        auto state = utf8proc_iterate(bytes + begin, count - begin, &codepoint);
+        if (state < 0 || !isWhitespace(codepoint)) break;
         begin += state;
     }
 
-    size_t end = begin - 1;
-    for (size_t i = begin; i < string->count;) {
+    // The index after the last character that is not whitespace.
+    size_t end = begin;
+    for (size_t i = begin; i < count;) {
+        if (bytes[i] < 0x80) {
+            if (!isWhitespace(bytes[i])) {
+                end = i + 1;
+            }
+            i++;
+            continue;
+        }
         utf8proc_int32_t codepoint;
-        auto state = utf8proc_iterate(reinterpret_cast<utf8proc_uint8_t *>(string->characters.get()) + i,
-                                      string->count, &codepoint);
+        auto state = utf8proc_iterate(bytes + i, count - i, &codepoint);
         if (state < 0) break;
-        if (utf8proc_get_property(codepoint)->bidi_class != UTF8PROC_BIDI_CLASS_WS) {
-            end = i;
+        if (!isWhitespace(codepoint)) {
+            end = i + state;
         }
         i += state;
     }
 
     auto newString = String::init();
-    newString->count = end - begin + 1;
-    newString->characters = runtime::allocate<char>(string->count);
+    newString->count = end - begin;
+    newString->characters = runtime::allocate<char>(count);
     std::memcpy(newString->characters.get(), string->characters.get() + begin, newString->count);
     return newString;
 }
 
-extern "C" void sStringGraphemes(String *string, runtime::Callable<void, s::String*> cb) {
-    auto bytes = reinterpret_cast<utf8proc_uint8_t *>(string->characters.get());
-    utf8proc_int32_t state = 0;
-    utf8proc_int32_t prev;
-
-    if (string->count == 0) {
-        return;
-    }
-
-    size_t lastCut = 0;
-    size_t off = utf8proc_iterate(bytes, string->count, &prev);
-
-    while (off < string->count) {
-        utf8proc_int32_t cp;
-        auto c = utf8proc_iterate(bytes + off, string->count, &cp);
-
-        if (utf8proc_grapheme_break_stateful(prev, cp, &state)) {
-            auto newString = String::init();
-            newString->count = off - lastCut;
-            newString->characters = runtime::allocate<char>(newString->count);
-            std::memcpy(newString->characters.get(), string->characters.get() + lastCut, newString->count);
-            lastCut = off;
-            cb(newString);
-            newString->release();
-        }
-        prev = cp;
-        off += c;
-    }
-
+static String* substring(String *string, size_t begin, size_t end) {
     auto newString = String::init();
-    newString->count = off - lastCut;
+    newString->count = end - begin;
     newString->characters = runtime::allocate<char>(newString->count);
-    std::memcpy(newString->characters.get(), string->characters.get() + lastCut, newString->count);
-    lastCut = off;
-    cb(newString);
-    newString->release();
+    std::memcpy(newString->characters.get(), string->characters.get() + begin, newString->count);
+    return newString;
 }
 
-extern "C" s::String* sStringGraphemeSubstring(String *string, runtime::Integer from, runtime::Integer length) {
-    auto bytes = reinterpret_cast<utf8proc_uint8_t *>(string->characters.get());
-    utf8proc_int32_t state = 0;
-    utf8proc_int32_t prev, cp;
-    size_t beginCut = 0, off = utf8proc_iterate(bytes, string->count, &prev);
-
-    if (length == 0) {
-        auto newString = String::init();
-        newString->count = 0;
-        newString->characters = runtime::allocate<char>(0);
-        return newString;
+extern "C" void sStringGraphemes(String *string, runtime::Callable<void, s::String*> cb) {
+    s::GraphemeWalker walker(string);
+    while (!walker.atEnd()) {
+        auto begin = walker.offset();
+        walker.next();
+        auto grapheme = substring(string, begin, walker.offset());
+        cb(grapheme);
+        grapheme->release();
     }
+}
 
-    while (off < string->count && from > 0) {
-        auto c = utf8proc_iterate(bytes + off, string->count, &cp);
-
-        if (utf8proc_grapheme_break_stateful(prev, cp, &state) && --from == 0) {
-            beginCut = off;
-            prev = cp;
-            off += c;
-            break;
-        }
-        prev = cp;
-        off += c;
-    }
-    while (off < string->count) {
-        auto c = utf8proc_iterate(bytes + off, string->count, &cp);
+extern "C" runtime::Integer sStringGraphemeCount(String *string) {
+    return s::GraphemeIndex::of(string)->count();
+}
 
-        if (utf8proc_grapheme_break_stateful(prev, cp, &state) && --length == 0) {
-            break;
-        }
-        prev = cp;
-        off += c;
+extern "C" s::String* sStringGraphemeSubstring(String *string, runtime::Integer from, runtime::Integer length) {
+    if (length <= 0) {
+        return substring(string, 0, 0);
     }
-
-    auto newString = String::init();
-    newString->count = off - beginCut;
-    newString->characters = runtime::allocate<char>(newString->count);
-    std::memcpy(newString->characters.get(), string->characters.get() + beginCut, newString->count);
-    return newString;
+    auto walker = s::GraphemeIndex::of(string)->walkerAt(string, std::max<runtime::Integer>(from, 0));
+    auto begin = walker.offset();
+    walker.advance(length);
+    return substring(string, begin, walker.offset());
 }
 
 runtime::SimpleOptional<runtime::Integer> sStringToIntLength(const char *characters,
@@ -289,64 +310,11 @@ extern "C" runtime::SimpleOptional<runtime::Integer> sStringToInt(String *string
 }
 
 extern "C" runtime::SimpleOptional<runtime::Real> sStringToReal(String *string) {
-    if (string->count == 0) {
+    runtime::Real real;
+    if (!s::numbers::parseReal(string->characters.get(), string->characters.get() + string->count, &real)) {
         return runtime::NoValue;
     }
-
-    runtime::Real d = 0.0;
-    bool sign = true;
-    bool foundSeparator = false;
-    bool foundDigit = false;
-    size_t decimalPlace = 0;
-    decltype(string->count) i = 0;
-
-    if (string->characters[0] == '-') {
-        sign = false;
-        i++;
-    }
-    else if (string->characters[0] == '+') {
-        i++;
-    }
-
-    for (; i < string->count; i++) {
-        if (string->characters[i] == '.') {
-            if (foundSeparator) {
-                return runtime::NoValue;
-            }
-            foundSeparator = true;
-            continue;
-        }
-        if (string->characters[i] == 'e' || string->characters[i] == 'E') {
-            auto exponent = sStringToIntLength(string->characters.get() + i + 1, string->count - i - 1, 10);
-            if (exponent == runtime::NoValue) {
-                return runtime::NoValue;
-            }
-            d *= std::pow(10, *exponent);
-            break;
-        }
-        if ('0' <= string->characters[i] && string->characters[i] <= '9') {
-            d *= 10;
-            d += string->characters[i] - '0';
-            if (foundSeparator) {
-                decimalPlace++;
-            }
-            foundDigit = true;
-        }
-        else {
-            return runtime::NoValue;
-        }
-    }
-
-    if (!foundDigit) {
-        return runtime::NoValue;
-    }
-
-    d /= std::pow(10, decimalPlace);
-
-    if (!sign) {
-        d *= -1;
-    }
-    return d;
+    return real;
 }
 
 extern "C" runtime::Integer sStringHash(String *string) {
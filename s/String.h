@@ -15,6 +15,8 @@
 
 namespace s {
 
+class GraphemeIndex;
+
 class String : public runtime::Object<String>  {
 public:
     String(const char *string);
@@ -28,6 +30,8 @@ public:
 
     runtime::MemoryPointer<char> characters;
     runtime::Integer count;
+    /// The index of the graphemes of this string, which is created lazily by GraphemeIndex::of().
+    GraphemeIndex *graphemeIndex = nullptr;
 
     std::string stdString();
     int compare(String *other);
@@ -107,9 +107,18 @@ compilation_tests = [
     "errorReraisePrefix",
     "weak",
     "superMemoryFlow",
-    "interpolationDereference"
+    "interpolationDereference",
+    "concurrentAnalysis",
+    "rcConstants"
 ]
 
+# Additional arguments passed to the compiler for compilation tests.
+compilation_test_arguments = {
+    "closureCapture": ["-j", "4"],
+    "concurrentAnalysis": ["--analysis-jobs", "4"],
+    "rcConstants": ["--lto"]
+}
+
 if not (quick or valgrind):
     compilation_tests.extend([
       "stressTest1",
@@ -163,7 +172,8 @@ def library_test(name):
 
 def compilation_test(name):
     source_path, binary_path = test_paths(name, 'compilation')
-    run([emojicodec, source_path, '-O'], check=True)
+    arguments = compilation_test_arguments.get(name, [])
+    run([emojicodec, source_path, '-O'] + arguments, check=True)
     completed = run([binary_path], stdout=PIPE)
     exp_path = os.path.join(dist.source, "tests", "compilation", name + ".txt")
     output = completed.stdout.decode('utf-8')